@@ -0,0 +1,102 @@
+#include "bench.hpp"
+
+#include "si/units.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace
+{
+constexpr std::size_t N = 4096;
+
+template <typename _Rep>
+const std::array<_Rep, N> &raw_input()
+{
+    static const auto values = [] {
+        std::array<_Rep, N> a{};
+        for (std::size_t i = 0; i < N; ++i) {
+            a[i] = static_cast<_Rep>(i * 7919 % 1009);
+        }
+        return a;
+    }();
+    return values;
+}
+
+template <typename _Unit>
+const std::array<_Unit, N> &unit_input()
+{
+    static const auto values = [] {
+        std::array<_Unit, N> a{};
+        const auto &raw = raw_input<typename _Unit::rep>();
+        for (std::size_t i = 0; i < N; ++i) {
+            a[i] = _Unit{raw[i]};
+        }
+        return a;
+    }();
+    return values;
+}
+
+template <typename _Rep>
+void accumulate_raw(si_bench::state &state)
+{
+    const auto &in = raw_input<_Rep>();
+    state.set_items_per_iteration(N);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        _Rep acc = 0;
+        for (const auto &v : in) acc += v;
+        si_bench::do_not_optimize(acc);
+    }
+}
+
+template <typename _Acc, typename _Unit>
+void accumulate_plus_assign(si_bench::state &state)
+{
+    const auto &in = unit_input<_Unit>();
+    state.set_items_per_iteration(N);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        _Acc acc{};
+        for (const auto &v : in) acc += v;
+        si_bench::do_not_optimize(acc);
+    }
+}
+
+template <typename _Acc, typename _Unit>
+void accumulate_plus(si_bench::state &state)
+{
+    const auto &in = unit_input<_Unit>();
+    state.set_items_per_iteration(N);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        _Acc acc{};
+        for (const auto &v : in) acc = acc + v;
+        si_bench::do_not_optimize(acc);
+    }
+}
+
+// the same accumulation with the ratio applied by hand, as += does on mixed ratios
+template <typename _Rep>
+void accumulate_raw_scaled(si_bench::state &state)
+{
+    const auto &in = raw_input<_Rep>();
+    state.set_items_per_iteration(N);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        _Rep acc = 0;
+        for (const auto &v : in) acc += v * 1000;
+        si_bench::do_not_optimize(acc);
+    }
+}
+} // namespace
+
+SI_BENCHMARK("accumulate/int64", "raw") { accumulate_raw<int64_t>(state); }
+SI_BENCHMARK("accumulate/int64", "unit +=") { accumulate_plus_assign<si::length<int64_t>, si::length<int64_t>>(state); }
+SI_BENCHMARK("accumulate/int64", "unit = unit + unit") { accumulate_plus<si::length<int64_t>, si::length<int64_t>>(state); }
+
+SI_BENCHMARK("accumulate/double", "raw") { accumulate_raw<double>(state); }
+SI_BENCHMARK("accumulate/double", "unit +=") { accumulate_plus_assign<si::length<double>, si::length<double>>(state); }
+SI_BENCHMARK("accumulate/double", "unit = unit + unit") { accumulate_plus<si::length<double>, si::length<double>>(state); }
+
+SI_BENCHMARK("accumulate/mixed int64", "raw scaled") { accumulate_raw_scaled<int64_t>(state); }
+SI_BENCHMARK("accumulate/mixed int64", "mm += m") { accumulate_plus_assign<si::length<int64_t, std::milli>, si::length<int64_t>>(state); }
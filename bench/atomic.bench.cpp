@@ -0,0 +1,80 @@
+#include "bench.hpp"
+
+#include "si/atomic.hpp"
+#include "si/units.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Every hardware thread adding to one shared counter, the time is per addition. The
+// baseline is the std::atomic<double> compare and swap loop written by hand; the
+// sharded counters only pay off with more than one thread contending.
+namespace
+{
+std::size_t thread_count()
+{
+    return std::max(2u, std::thread::hardware_concurrency());
+}
+
+template<typename _Add>
+void bench_contention(si_bench::state &state, _Add add)
+{
+    const auto threads = thread_count();
+    state.set_items_per_iteration(threads);
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            for (std::size_t i = 0; i < state.iterations(); ++i) add();
+        });
+    }
+    for (auto &w : workers) w.join();
+}
+
+void raw_double(si_bench::state &state)
+{
+    std::atomic<double> total{0.0};
+    bench_contention(state, [&] {
+        auto old = total.load(std::memory_order_relaxed);
+        while (!total.compare_exchange_weak(old, old + 1.5)) {
+        }
+    });
+    si_bench::do_not_optimize(total.load());
+}
+
+template<typename _Counter, typename _Unit>
+void unit_counter(si_bench::state &state, _Unit delta)
+{
+    _Counter total;
+    bench_contention(state, [&] { total += delta; });
+    si_bench::do_not_optimize(total.load());
+}
+
+void raw_int64(si_bench::state &state)
+{
+    std::atomic<std::int64_t> total{0};
+    bench_contention(state, [&] { total.fetch_add(1500); });
+    si_bench::do_not_optimize(total.load());
+}
+} // namespace
+
+SI_BENCHMARK("atomic/energy<double>", "std::atomic<double>") { raw_double(state); }
+SI_BENCHMARK("atomic/energy<double>", "atomic_unit") {
+    unit_counter<si::atomic_unit<si::energy<double>>>(state, si::energy<double>{1.5});
+}
+SI_BENCHMARK("atomic/energy<double>", "atomic_unit, kJ") {
+    unit_counter<si::atomic_unit<si::energy<double>>>(state, si::energy<double, std::kilo>{0.0015});
+}
+SI_BENCHMARK("atomic/energy<double>", "sharded_atomic_unit") {
+    unit_counter<si::sharded_atomic_unit<si::energy<double>>>(state, si::energy<double>{1.5});
+}
+
+SI_BENCHMARK("atomic/length<int64_t>", "std::atomic<int64_t>") { raw_int64(state); }
+SI_BENCHMARK("atomic/length<int64_t>", "atomic_unit, m") {
+    unit_counter<si::atomic_unit<si::length<std::int64_t, std::milli>>>(state, si::length<int>{1});
+}
+SI_BENCHMARK("atomic/length<int64_t>", "sharded_atomic_unit, m") {
+    unit_counter<si::sharded_atomic_unit<si::length<std::int64_t, std::milli>>>(state, si::length<int>{1});
+}
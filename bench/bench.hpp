@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// A minimal benchmark harness, just enough to compare the cost of si against
+// the equivalent raw arithmetic without pulling in any external dependency.
+//
+// Every benchmark runs its body `state.iterations()` times, the harness picks the
+// number of iterations so that a run lasts long enough to be measured reliably.
+// The first benchmark registered in a group is used as the baseline for the others.
+namespace si_bench
+{
+class state
+{
+public:
+    explicit state(std::size_t iterations)
+        : _iterations(iterations) { }
+
+    std::size_t iterations() const { return _iterations; }
+
+    // number of elements and bytes processed by a single iteration, used to
+    // report the throughput of batch benchmarks
+    void set_items_per_iteration(std::size_t items) { _items = items; }
+    void set_bytes_per_iteration(std::size_t bytes) { _bytes = bytes; }
+
+    std::size_t items_per_iteration() const { return _items; }
+    std::size_t bytes_per_iteration() const { return _bytes; }
+
+    // for benchmarks that cannot run on this machine
+    void skip() { _skipped = true; }
+    bool skipped() const { return _skipped; }
+
+private:
+    std::size_t _iterations;
+    std::size_t _items = 1;
+    std::size_t _bytes = 0;
+    bool _skipped = false;
+};
+
+struct benchmark
+{
+    const char *group;
+    const char *name;
+    void (*fn)(state &);
+};
+
+inline std::vector<benchmark> &registry()
+{
+    static std::vector<benchmark> benchmarks;
+    return benchmarks;
+}
+
+struct registrar
+{
+    registrar(const char *group, const char *name, void (*fn)(state &))
+    {
+        registry().push_back({group, name, fn});
+    }
+};
+
+// prevent the compiler from optimising away a value, or the computation leading to it
+template <typename T>
+inline void do_not_optimize(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// prevent the compiler from assuming anything about the contents of memory
+inline void clobber()
+{
+    asm volatile("" : : : "memory");
+}
+} // namespace si_bench
+
+#define SI_BENCH_CAT2(a, b) a##b
+#define SI_BENCH_CAT(a, b) SI_BENCH_CAT2(a, b)
+
+#define SI_BENCHMARK(group, name) SI_BENCHMARK_IMPL(group, name, __COUNTER__)
+
+#define SI_BENCHMARK_IMPL(group, name, id)                                        \
+    static void SI_BENCH_CAT(si_bench_fn_, id)(si_bench::state &);                \
+    static const si_bench::registrar SI_BENCH_CAT(si_bench_reg_, id){             \
+        group, name, &SI_BENCH_CAT(si_bench_fn_, id)};                            \
+    static void SI_BENCH_CAT(si_bench_fn_, id)(si_bench::state & state)
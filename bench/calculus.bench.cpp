@@ -0,0 +1,86 @@
+#include "bench.hpp"
+
+#include "si/calculus.hpp"
+#include "si/units.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Metering the energy of power samples taken every 10 ms. The baseline sums raw doubles
+// with the trapezoid rule and no compensation, then si::uniform_integrator by chunks with
+// both rules and sample by sample, and si::integrator with a timestamp per sample.
+namespace
+{
+constexpr std::size_t N = 1 << 16;
+
+using power       = si::power<double>;
+using nanoseconds = si::time<std::int64_t, std::nano>;
+
+struct samples
+{
+    std::vector<power> values;
+
+    samples()
+    {
+        for (std::size_t i = 0; i < N; ++i) values.emplace_back(1000 + 50 * std::sin(i * 0.01));
+    }
+};
+
+template<typename _Meter>
+void bench_meter(si_bench::state &state, _Meter meter)
+{
+    const samples s;
+    state.set_items_per_iteration(N);
+    state.set_bytes_per_iteration(N * sizeof(power));
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        auto consumed = meter(s.values);
+        si_bench::do_not_optimize(consumed);
+    }
+}
+
+void raw(si_bench::state &state)
+{
+    bench_meter(state, [](const std::vector<power> &values) {
+        const auto *w = reinterpret_cast<const double *>(values.data());
+        double sum = 0;
+        for (std::size_t i = 0; i < N; ++i) sum += w[i];
+        return 0.01 * (sum - 0.5 * (w[0] + w[N - 1]));
+    });
+}
+
+template<si::rule _Rule>
+void chunks(si_bench::state &state)
+{
+    bench_meter(state, [](const std::vector<power> &values) {
+        si::uniform_integrator<power, _Rule> meter{si::millisecond{10}};
+        for (std::size_t i = 0; i < N; i += 1024) meter.push(si::span<const power>{values.data() + i, 1024});
+        return meter.total();
+    });
+}
+
+void one_by_one(si_bench::state &state)
+{
+    bench_meter(state, [](const std::vector<power> &values) {
+        si::uniform_integrator<power> meter{si::millisecond{10}};
+        for (const auto &value : values) meter.push(value);
+        return meter.total();
+    });
+}
+
+void timestamped(si_bench::state &state)
+{
+    bench_meter(state, [](const std::vector<power> &values) {
+        si::integrator<power, nanoseconds> meter;
+        for (std::size_t i = 0; i < N; ++i) meter.push(nanoseconds{static_cast<std::int64_t>(i) * 10000000}, values[i]);
+        return meter.total();
+    });
+}
+} // namespace
+
+SI_BENCHMARK("calculus/energy of power samples", "raw double, trapezoid") { raw(state); }
+SI_BENCHMARK("calculus/energy of power samples", "uniform_integrator, trapezoid, chunks") { chunks<si::rule::trapezoid>(state); }
+SI_BENCHMARK("calculus/energy of power samples", "uniform_integrator, simpson, chunks") { chunks<si::rule::simpson>(state); }
+SI_BENCHMARK("calculus/energy of power samples", "uniform_integrator, one by one") { one_by_one(state); }
+SI_BENCHMARK("calculus/energy of power samples", "integrator, timestamped") { timestamped(state); }
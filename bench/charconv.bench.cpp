@@ -0,0 +1,223 @@
+#include "bench.hpp"
+
+#include "si/charconv.hpp"
+#include "si/io.hpp"
+#include "si/units.hpp"
+
+#include <charconv>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t N = 1 << 14;
+
+// one value per line, the way they arrive on the ingest path
+template<typename _Make>
+std::string make_input(_Make make)
+{
+    std::string text;
+    for (std::size_t i = 0; i < N; ++i) {
+        text += make(i);
+        text += '\n';
+    }
+    return text;
+}
+
+const std::string &lengths()
+{
+    static const auto text = make_input([](std::size_t i) {
+        const char *symbols[] = {"km", "m", "mm", "µm", "cm", "nm", "Mm"};
+        return std::to_string(i % 997) + "." + std::to_string(i % 10) + " " + symbols[i % 7];
+    });
+    return text;
+}
+
+const std::string &integer_times()
+{
+    static const auto text = make_input([](std::size_t i) {
+        const char *symbols[] = {"s", "ms", "us", "ns", "ks"};
+        return std::to_string(i * 7919 % 100003) + " " + symbols[i % 5];
+    });
+    return text;
+}
+
+const std::string &pressures()
+{
+    static const auto text = make_input([](std::size_t i) {
+        const char *symbols[] = {"Pa", "kPa", "hPa", "MPa"};
+        return std::to_string(i % 97) + "." + std::to_string(i % 13) + "e" + std::to_string(i % 4) + " " + symbols[i % 4];
+    });
+    return text;
+}
+
+// what the ingest path did before si::from_chars: a number, then the symbol compared
+// against every known spelling
+bool hand_written(const char *&p, const char *last, double &metres)
+{
+    double value;
+    auto r = std::from_chars(p, last, value);
+    if (r.ec != std::errc{}) return false;
+    p = r.ptr;
+    while (p != last && *p == ' ') ++p;
+    const char *first = p;
+    while (p != last && *p != '\n') ++p;
+    std::string_view symbol(first, static_cast<std::size_t>(p - first));
+
+    if (symbol == "m") metres = value;
+    else if (symbol == "km") metres = value * 1e3;
+    else if (symbol == "Mm") metres = value * 1e6;
+    else if (symbol == "cm") metres = value / 1e2;
+    else if (symbol == "mm") metres = value / 1e3;
+    else if (symbol == "µm") metres = value / 1e6;
+    else if (symbol == "nm") metres = value / 1e9;
+    else return false;
+    return true;
+}
+
+template<typename _Unit>
+const std::vector<_Unit> &values()
+{
+    static const auto units = [] {
+        std::vector<_Unit> v;
+        for (std::size_t i = 0; i < N; ++i) {
+            v.emplace_back(static_cast<typename _Unit::rep>(i * 7919 % 100003) / 8);
+        }
+        return v;
+    }();
+    return units;
+}
+
+template<typename _Unit>
+void bench_si_from_chars(si_bench::state &state, const std::string &text)
+{
+    state.set_items_per_iteration(N);
+    state.set_bytes_per_iteration(text.size());
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        const char *p = text.data();
+        const char *last = p + text.size();
+        _Unit value;
+        while (p != last) {
+            auto r = si::from_chars(p, last, value);
+            si_bench::do_not_optimize(value);
+            p = r.ptr + 1;
+        }
+    }
+}
+} // namespace
+
+SI_BENCHMARK("from_chars/length double", "std::from_chars number only")
+{
+    const auto &text = lengths();
+    state.set_items_per_iteration(N);
+    state.set_bytes_per_iteration(text.size());
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        const char *p = text.data();
+        const char *last = p + text.size();
+        double value = 0;
+        while (p != last) {
+            auto r = std::from_chars(p, last, value);
+            si_bench::do_not_optimize(value);
+            p = r.ptr;
+            while (*p++ != '\n') { }
+        }
+    }
+}
+
+SI_BENCHMARK("from_chars/length double", "hand-written symbol compare")
+{
+    const auto &text = lengths();
+    state.set_items_per_iteration(N);
+    state.set_bytes_per_iteration(text.size());
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        const char *p = text.data();
+        const char *last = p + text.size();
+        double value = 0;
+        while (p != last) {
+            hand_written(p, last, value);
+            si_bench::do_not_optimize(value);
+            ++p;
+        }
+    }
+}
+
+SI_BENCHMARK("from_chars/length double", "si::from_chars")
+{
+    bench_si_from_chars<si::length<double>>(state, lengths());
+}
+
+SI_BENCHMARK("from_chars/time int64", "si::from_chars")
+{
+    bench_si_from_chars<si::time<int64_t, std::nano>>(state, integer_times());
+}
+
+SI_BENCHMARK("from_chars/pressure double", "si::from_chars")
+{
+    bench_si_from_chars<si::pressure<double>>(state, pressures());
+}
+
+namespace
+{
+// the logger writes every value into the same reused buffer
+template<typename _Unit, typename _Write>
+void bench_format(si_bench::state &state, _Write write)
+{
+    const auto &units = values<_Unit>();
+    state.set_items_per_iteration(N);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        for (const auto &u : units) {
+            write(u);
+        }
+    }
+}
+
+template<typename _Unit>
+void bench_ostringstream(si_bench::state &state, const char *symbol)
+{
+    std::ostringstream os;
+    bench_format<_Unit>(state, [&](const _Unit &u) {
+        os.str({});
+        os << u.count() << ' ' << symbol;
+        si_bench::do_not_optimize(os);
+    });
+}
+
+template<typename _Unit>
+void bench_operator(si_bench::state &state)
+{
+    std::ostringstream os;
+    bench_format<_Unit>(state, [&](const _Unit &u) {
+        os.str({});
+        os << u;
+        si_bench::do_not_optimize(os);
+    });
+}
+
+template<typename _Unit>
+void bench_to_chars(si_bench::state &state, si::prefix_mode mode)
+{
+    char buffer[64];
+    bench_format<_Unit>(state, [&](const _Unit &u) {
+        auto r = si::to_chars(buffer, buffer + sizeof(buffer), u, mode);
+        si_bench::do_not_optimize(r.ptr);
+        si_bench::clobber();
+    });
+}
+
+using km_d  = si::length<double, std::kilo>;
+using ms_i  = si::millisecond;
+using acc_d = si::acceleration<double>;
+} // namespace
+
+#define SI_TO_CHARS_BENCHMARKS(group, unit, symbol)                                            \
+    SI_BENCHMARK(group, "ostringstream count + symbol") { bench_ostringstream<unit>(state, symbol); } \
+    SI_BENCHMARK(group, "ostringstream si::operator<<") { bench_operator<unit>(state); }        \
+    SI_BENCHMARK(group, "si::to_chars exact") { bench_to_chars<unit>(state, si::prefix_mode::exact); } \
+    SI_BENCHMARK(group, "si::to_chars automatic") { bench_to_chars<unit>(state, si::prefix_mode::automatic); }
+
+SI_TO_CHARS_BENCHMARKS("to_chars/km double", km_d, "km")
+SI_TO_CHARS_BENCHMARKS("to_chars/ms int", ms_i, "ms")
+SI_TO_CHARS_BENCHMARKS("to_chars/m*s^-2 double", acc_d, "m·s⁻²")
@@ -0,0 +1,88 @@
+#include "bench.hpp"
+
+#include "si/charconv.hpp"
+#include "si/column_file.hpp"
+#include "si/units.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t N = 1 << 16;
+
+using pressure = si::pressure<double>;
+
+const std::vector<pressure> &pressures()
+{
+    static const auto values = [] {
+        std::vector<pressure> v;
+        for (std::size_t i = 0; i < N; ++i) v.emplace_back(101325.0 + static_cast<double>(i * 7919 % 1009) / 8);
+        return v;
+    }();
+    return values;
+}
+
+// the same values as text, one per line, already in memory
+const std::string &text()
+{
+    static const auto values = [] {
+        std::string s;
+        char buffer[64];
+        for (const auto &p : pressures()) {
+            const auto r = si::to_chars(buffer, buffer + sizeof(buffer), p);
+            s.append(buffer, r.ptr);
+            s += '\n';
+        }
+        return s;
+    }();
+    return values;
+}
+
+// and as a column file, written once
+const std::string &file()
+{
+    static const auto path = [] {
+        auto p = (std::filesystem::temp_directory_path() / "si_column_file.bench.sicol").string();
+        si::column_writer w;
+        w.open(p.c_str());
+        w.write("pressure", pressures());
+        w.close();
+        return p;
+    }();
+    return path;
+}
+} // namespace
+
+SI_BENCHMARK("columns/sum 64k pressures", "si::from_chars")
+{
+    const auto &s = text();
+    state.set_items_per_iteration(N);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        const char *p = s.data();
+        const char *last = p + s.size();
+        pressure sum{0}, value;
+        while (p != last) {
+            p = si::from_chars(p, last, value).ptr + 1;
+            sum += value;
+        }
+        si_bench::do_not_optimize(sum);
+    }
+}
+
+SI_BENCHMARK("columns/sum 64k pressures", "column_file open and map")
+{
+    const auto &path = file();
+    state.set_items_per_iteration(N);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si::column_file f;
+        si::span<const pressure> column;
+        f.open(path.c_str());
+        f.column("pressure", column);
+        pressure sum{0};
+        for (const auto &p : column) sum += p;
+        si_bench::do_not_optimize(sum);
+    }
+}
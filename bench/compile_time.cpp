@@ -0,0 +1,331 @@
+// Measures what the templates of si cost to compile.
+//
+// Generates translation units instantiating an increasing number of distinct units
+// and operator chains, compiles each of them with the compiler given on the command
+// line and reports the wall time, the cpu time and the peak memory of the compiler,
+// and the size of the object it wrote.
+//
+//     si_compile_bench [--out dir] [--repetitions n] -- c++ -std=c++17 -Iinclude
+//
+// Anything after `--` is the compiler and its flags, e.g. `-ftime-trace` with clang
+// leaves a trace next to every object for a closer look at a regression.
+//
+// With `--module include/si/si.cppm` it instead compares a project of `--project n`
+// translation units including si/si.hpp with the same project importing the module
+// si, which is compiled once first. That follows the GCC flow, where the compiled
+// interface is written to gcm.cache in the working directory:
+//
+//     si_compile_bench --module include/si/si.cppm -- g++ -std=c++20 -fmodules-ts -Iinclude
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <spawn.h>
+
+extern char **environ;
+
+namespace
+{
+struct measurement
+{
+    double wall_ms = 0;
+    double cpu_ms  = 0;
+    long max_rss_kb = 0;
+    long object_bytes = 0;
+};
+
+double to_ms(const timeval &tv)
+{
+    return tv.tv_sec * 1e3 + tv.tv_usec / 1e3;
+}
+
+// runs the command, the usage of the compiler proper is included since the
+// driver waits for it
+bool run(const std::vector<std::string> &command, measurement &m)
+{
+    std::vector<char *> argv;
+    for (const auto &arg : command) argv.push_back(const_cast<char *>(arg.c_str()));
+    argv.push_back(nullptr);
+
+    const auto start = std::chrono::steady_clock::now();
+    pid_t pid;
+    if (posix_spawnp(&pid, argv[0], nullptr, nullptr, argv.data(), environ) != 0) {
+        std::perror(argv[0]);
+        return false;
+    }
+
+    int status;
+    rusage usage;
+    if (wait4(pid, &status, 0, &usage) != pid) return false;
+    const auto stop = std::chrono::steady_clock::now();
+
+    m.wall_ms    = std::chrono::duration<double, std::milli>(stop - start).count();
+    m.cpu_ms     = to_ms(usage.ru_utime) + to_ms(usage.ru_stime);
+    m.max_rss_kb = usage.ru_maxrss;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// exponents of the i-th distinct dimension, each base in [-2, 2]
+std::string base_of(std::size_t i)
+{
+    std::string base = "si::detail::base<";
+    for (int d = 0; d < 7; ++d, i /= 5) {
+        base += std::to_string(static_cast<int>(i % 5) - 2);
+        base += d < 6 ? ", " : ">";
+    }
+    return base;
+}
+
+std::string includes(const char *header)
+{
+    return std::string("#include \"") + header + "\"\n";
+}
+
+// every derived alias of si/units.hpp, each one a chain of operators, for n ratios
+std::string named_units(std::size_t n, const std::string &prelude = includes("si/units.hpp"))
+{
+    static const char *aliases[] = {
+        "velocity", "acceleration", "frequency", "pressure", "energy", "power",
+        "electric_charge", "voltage", "capacitance", "electric_resistance",
+        "electrical_conductance", "magnetic_flux", "magnetic_flux_density", "inductance",
+        "luminous_flux", "illuminance", "absorbed_dose", "catalytic_activity"};
+
+    std::string tu = prelude + "\ndouble sum(double x)\n{\n    double s = 0;\n";
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto ratio = "std::ratio<1, " + std::to_string(i + 1) + ">";
+        for (const char *alias : aliases) {
+            tu += "    s += si::" + std::string(alias) + "<double, " + ratio + ">{x}.count();\n";
+        }
+    }
+    return tu + "    return s;\n}\n";
+}
+
+// n units of distinct dimensions, each added to and compared with another ratio of
+// itself, cast, and multiplied and divided by the next one
+std::string distinct_units(std::size_t n)
+{
+    std::string tu = includes("si/core.hpp") + "\n";
+    for (std::size_t i = 0; i <= n; ++i) {
+        const auto n_i = std::to_string(i);
+        tu += "using u" + n_i + " = si::unit<double, std::ratio<1, " + std::to_string(i + 1) + ">, "
+            + base_of(i) + ">;\n";
+        tu += "using v" + n_i + " = si::unit<double, std::milli, " + base_of(i) + ">;\n";
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto n_i = std::to_string(i);
+        const auto next = std::to_string(i + 1);
+        tu += "\ndouble f" + n_i + "(double x)\n{\n"
+            "    u" + n_i + " a{x};\n"
+            "    v" + n_i + " b{x};\n"
+            "    u" + next + " c{x};\n"
+            "    return (a + b).count() + (a - b).count() + (a < b) + (a == b)\n"
+            "         + si::unit_cast<v" + n_i + ">(a).count() + (a * c).count() + (a / c).count();\n"
+            "}\n";
+    }
+    return tu;
+}
+
+// every prefixed base unit with the representations SI::SI_compiled instantiates, for
+// comparing a build with SI_COMPILED defined against one without
+std::string prefixed_units()
+{
+    static const char *dimensions[] = {"length", "mass", "time", "current", "temperature", "amount",
+                                       "luminous_intensity"};
+    static const char *prefixes[] = {"nano", "micro", "milli", "centi", "deci", "ratio<1>", "kilo", "mega", "giga"};
+    static const char *reps[] = {"int", "float", "double", "std::int64_t"};
+
+    std::string tu = includes("si/units.hpp") + "#include <cstdint>\n\ndouble sum(double x)\n{\n    double s = 0;\n";
+    for (const char *rep : reps) {
+        for (const char *dimension : dimensions) {
+            for (const char *prefix : prefixes) {
+                const auto type = "si::" + std::string(dimension) + "<" + rep + ", std::" + prefix + ">";
+                const auto value = type + "{static_cast<" + rep + ">(x)}";
+                tu += "    {\n        " + type + " a = " + value + " + " + value + ";\n"
+                      "        a += " + value + ";\n        a *= static_cast<" + rep + ">(x);\n"
+                      "        s += (a < " + value + ") + (++a).count();\n    }\n";
+            }
+        }
+    }
+    return tu + "    return s;\n}\n";
+}
+
+// n units whose ratios are written differently but have the same value, multiplied,
+// divided and added: with canonical ratios every one of them instantiates the same
+// operators, otherwise each is a unit of its own
+std::string equal_ratios(std::size_t n)
+{
+    std::string tu = includes("si/core.hpp") + "\n"
+        "using half_second = si::unit<double, std::ratio<1, 2>, si::detail::base<0, 0, 1>>;\n";
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto n_i = std::to_string(i);
+        const auto ratio = "std::ratio<" + std::to_string(i + 1) + ", " + std::to_string(2 * (i + 1)) + ">";
+        tu += "\ndouble g" + n_i + "(double x)\n{\n"
+            "    si::unit<double, " + ratio + ", si::detail::base<1>> a{x};\n"
+            "    half_second t{x};\n"
+            "    const auto v = a / t;\n"
+            "    const auto p = v * t;\n"
+            "    return (p + a).count() + (p * v).count() + (v / v).count();\n"
+            "}\n";
+    }
+    return tu;
+}
+
+struct translation_unit
+{
+    std::string name;
+    std::function<std::string()> source;
+};
+
+std::vector<translation_unit> translation_units()
+{
+    std::vector<translation_unit> tus = {
+        {"include si/core.hpp", [] { return includes("si/core.hpp"); }},
+        {"include si/units.hpp", [] { return includes("si/units.hpp"); }},
+        {"include si/si.hpp", [] { return includes("si/si.hpp"); }},
+    };
+    for (std::size_t n : {1, 8, 32}) {
+        tus.push_back({"named units x" + std::to_string(n), [n] { return named_units(n); }});
+    }
+    for (std::size_t n : {16, 64, 256}) {
+        tus.push_back({"distinct units x" + std::to_string(n), [n] { return distinct_units(n); }});
+    }
+    for (std::size_t n : {64, 256}) {
+        tus.push_back({"equal ratios x" + std::to_string(n), [n] { return equal_ratios(n); }});
+    }
+    tus.push_back({"prefixed units", [] { return prefixed_units(); }});
+    return tus;
+}
+
+// the importers name std::ratio themselves, the module does not export std
+std::string imports()
+{
+    return "#include <ratio>\n\nimport si;\n";
+}
+
+// compiles `source` into `object`, keeping the fastest of the repetitions
+bool compile(std::vector<std::string> command, const std::string &source, const std::string &object,
+             int repetitions, measurement &best)
+{
+    command.insert(command.end(), {"-c", source, "-o", object});
+
+    // the fastest run is the least disturbed one, memory barely varies
+    for (int r = 0; r < repetitions; ++r) {
+        measurement m;
+        if (!run(command, m)) {
+            std::fprintf(stderr, "failed to compile %s\n", source.c_str());
+            return false;
+        }
+        if (r == 0 || m.wall_ms < best.wall_ms) best = m;
+    }
+    struct stat st;
+    if (stat(object.c_str(), &st) == 0) best.object_bytes = st.st_size;
+    return true;
+}
+
+// writes `source` to `path`.cpp and compiles it
+bool measure(const std::vector<std::string> &compiler, const std::string &path, const std::string &source,
+             int repetitions, measurement &best)
+{
+    std::ofstream(path + ".cpp") << source;
+    return compile(compiler, path + ".cpp", path + ".o", repetitions, best);
+}
+
+void print(const std::string &name, const measurement &m)
+{
+    std::printf("%-28s %10.1f %10.1f %12ld %12ld\n", name.c_str(), m.wall_ms, m.cpu_ms, m.max_rss_kb,
+                m.object_bytes);
+}
+
+// the times and objects of a whole project add up, its memory is that of the
+// largest translation unit
+void add(measurement &total, const measurement &m)
+{
+    total.wall_ms += m.wall_ms;
+    total.cpu_ms += m.cpu_ms;
+    total.max_rss_kb = std::max(total.max_rss_kb, m.max_rss_kb);
+    total.object_bytes += m.object_bytes;
+}
+
+int compare_module(const std::vector<std::string> &compiler, const std::string &out, const std::string &interface,
+                   std::size_t project, int repetitions)
+{
+    // GCC does not know the .cppm extension
+    auto command = compiler;
+    command.insert(command.end(), {"-x", "c++"});
+    measurement module;
+    if (!compile(command, interface, out + "/module.o", repetitions, module)) return 1;
+
+    measurement included, imported;
+    for (std::size_t i = 0; i < project; ++i) {
+        const auto path = out + "/project_" + std::to_string(i);
+        measurement m;
+        if (!measure(compiler, path + "_include", named_units(1, includes("si/si.hpp")), repetitions, m)) return 1;
+        add(included, m);
+        if (!measure(compiler, path + "_import", named_units(1, imports()), repetitions, m)) return 1;
+        add(imported, m);
+    }
+
+    const auto x = " x" + std::to_string(project);
+    print("module si", module);
+    print("include si/si.hpp" + x, included);
+    print("import si" + x, imported);
+    add(imported, module);
+    print("import si" + x + " + module", imported);
+    return 0;
+}
+
+int usage(const char *self)
+{
+    std::fprintf(stderr,
+                 "usage: %s [--out dir] [--repetitions n] [--module interface [--project n]] -- compiler [flags...]\n",
+                 self);
+    return 2;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::string out = ".";
+    int repetitions = 3;
+    std::string module;
+    std::size_t project = 16;
+    std::vector<std::string> compiler;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--") == 0) {
+            compiler.assign(argv + i + 1, argv + argc);
+            break;
+        } else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out = argv[++i];
+        } else if (std::strcmp(argv[i], "--repetitions") == 0 && i + 1 < argc) {
+            repetitions = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--module") == 0 && i + 1 < argc) {
+            module = argv[++i];
+        } else if (std::strcmp(argv[i], "--project") == 0 && i + 1 < argc) {
+            project = static_cast<std::size_t>(std::max(1, std::atoi(argv[++i])));
+        } else {
+            return usage(argv[0]);
+        }
+    }
+    if (compiler.empty()) return usage(argv[0]);
+
+    std::printf("%-28s %10s %10s %12s %12s\n", "translation unit", "wall ms", "cpu ms", "max rss KB", "object B");
+    if (!module.empty()) return compare_module(compiler, out, module, project, repetitions);
+
+    int index = 0;
+    for (const auto &tu : translation_units()) {
+        measurement best;
+        if (!measure(compiler, out + "/compile_" + std::to_string(index++), tu.source(), repetitions, best)) return 1;
+        print(tu.name, best);
+    }
+}
@@ -0,0 +1,168 @@
+#include "bench.hpp"
+
+#include "si/convert.hpp"
+#include "si/half.hpp"
+#include "si/units.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t N = 1 << 16;
+
+template<typename _From>
+const std::vector<_From> &input()
+{
+    static const auto values = [] {
+        std::vector<_From> v;
+        for (std::size_t i = 0; i < N; ++i) {
+            v.emplace_back(static_cast<typename _From::rep>(i * 7919 % 100003 % 65504));
+        }
+        return v;
+    }();
+    return values;
+}
+
+template<typename _To, typename _From>
+void bench_scalar_loop(si_bench::state &state)
+{
+    const auto &in = input<_From>();
+    std::vector<_To> out(N);
+    state.set_items_per_iteration(N);
+    state.set_bytes_per_iteration(N * (sizeof(_From) + sizeof(_To)));
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        for (std::size_t j = 0; j < N; ++j) {
+            out[j] = si::unit_cast<_To>(in[j]);
+        }
+        si_bench::do_not_optimize(out.data());
+    }
+}
+
+template<typename _To, typename _From, void (*_Kernel)(const _From *, _To *, std::size_t)>
+void bench_kernel(si_bench::state &state)
+{
+    const auto &in = input<_From>();
+    std::vector<_To> out(N);
+    state.set_items_per_iteration(N);
+    state.set_bytes_per_iteration(N * (sizeof(_From) + sizeof(_To)));
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        _Kernel(in.data(), out.data(), N);
+        si_bench::do_not_optimize(out.data());
+    }
+}
+
+template<typename _To, typename _From>
+void bench_convert(si_bench::state &state)
+{
+    const auto &in = input<_From>();
+    std::vector<_To> out(N);
+    state.set_items_per_iteration(N);
+    state.set_bytes_per_iteration(N * (sizeof(_From) + sizeof(_To)));
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        si::convert(si::span<const _From>{in}, si::span<_To>{out});
+        si_bench::do_not_optimize(out.data());
+    }
+}
+
+#if SI_CONVERT_X86_DISPATCH
+template<typename _To, typename _From>
+void bench_sse2(si_bench::state &state)
+{
+    bench_kernel<_To, _From, &si::detail::convert_sse2<_To, _From>>(state);
+}
+
+template<typename _To, typename _From>
+void bench_avx2(si_bench::state &state)
+{
+    if (si::detail::native_isa() < si::detail::isa::avx2) return state.skip();
+    bench_kernel<_To, _From, &si::detail::convert_avx2<_To, _From>>(state);
+}
+
+template<typename _To, typename _From>
+void bench_avx512(si_bench::state &state)
+{
+    if (si::detail::native_isa() < si::detail::isa::avx512) return state.skip();
+    bench_kernel<_To, _From, &si::detail::convert_avx512<_To, _From>>(state);
+}
+#endif
+
+// scheduler buffers of std::chrono::nanoseconds read as seconds, element by element
+// through the conversion constructor of si::time and with si::from_durations
+const std::vector<std::chrono::nanoseconds> &deadlines()
+{
+    static const auto values = [] {
+        std::vector<std::chrono::nanoseconds> v;
+        for (std::size_t i = 0; i < N; ++i) v.emplace_back(static_cast<std::int64_t>(i * 7919 % 100003));
+        return v;
+    }();
+    return values;
+}
+
+void bench_durations_loop(si_bench::state &state)
+{
+    const auto &in = deadlines();
+    std::vector<si::time<double>> out(N);
+    state.set_items_per_iteration(N);
+    state.set_bytes_per_iteration(N * 16);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        for (std::size_t j = 0; j < N; ++j) out[j] = in[j];
+        si_bench::do_not_optimize(out.data());
+    }
+}
+
+void bench_from_durations(si_bench::state &state)
+{
+    const auto &in = deadlines();
+    std::vector<si::time<double>> out(N);
+    state.set_items_per_iteration(N);
+    state.set_bytes_per_iteration(N * 16);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        si::from_durations(si::span<const std::chrono::nanoseconds>{in}, si::span<si::time<double>>{out});
+        si_bench::do_not_optimize(out.data());
+    }
+}
+
+using ns_i32 = si::time<int32_t, std::nano>;
+using ms_i32 = si::time<int32_t, std::milli>;
+using ns_i64 = si::time<int64_t, std::nano>;
+using ms_i64 = si::time<int64_t, std::milli>;
+using mg_f   = si::mass<float, std::milli>;
+using kg_f   = si::mass<float>;
+using mg_d   = si::mass<double, std::milli>;
+using kg_d   = si::mass<double>;
+using m_bf16 = si::length<si::bfloat16>;
+using m_f    = si::length<float>;
+#if SI_HAS_FLOAT16
+using m_f16  = si::length<si::float16_t>;
+#endif
+} // namespace
+
+#define SI_CONVERT_BENCHMARKS(group, to, from)                                        \
+    SI_BENCHMARK(group, "unit_cast loop") { bench_scalar_loop<to, from>(state); }     \
+    SI_BENCHMARK(group, "kernel sse2") { bench_sse2<to, from>(state); }               \
+    SI_BENCHMARK(group, "kernel avx2") { bench_avx2<to, from>(state); }               \
+    SI_BENCHMARK(group, "kernel avx512") { bench_avx512<to, from>(state); }           \
+    SI_BENCHMARK(group, "si::convert") { bench_convert<to, from>(state); }
+
+#if SI_CONVERT_X86_DISPATCH
+SI_CONVERT_BENCHMARKS("convert/ns->ms int32", ms_i32, ns_i32)
+SI_CONVERT_BENCHMARKS("convert/ms->ns int64", ns_i64, ms_i64)
+SI_CONVERT_BENCHMARKS("convert/mg->kg float", kg_f, mg_f)
+SI_CONVERT_BENCHMARKS("convert/mg->kg double", kg_d, mg_d)
+SI_CONVERT_BENCHMARKS("convert/widen bfloat16", m_f, m_bf16)
+SI_CONVERT_BENCHMARKS("convert/narrow bfloat16", m_bf16, m_f)
+#if SI_HAS_FLOAT16
+SI_CONVERT_BENCHMARKS("convert/widen float16", m_f, m_f16)
+SI_CONVERT_BENCHMARKS("convert/narrow float16", m_f16, m_f)
+#endif
+#endif
+
+SI_BENCHMARK("convert/nanoseconds->s double", "si::time constructor loop") { bench_durations_loop(state); }
+SI_BENCHMARK("convert/nanoseconds->s double", "si::from_durations") { bench_from_durations(state); }
@@ -0,0 +1,87 @@
+#include "bench.hpp"
+
+#include "si/dynamic_unit.hpp"
+#include "si/units.hpp"
+
+#include <array>
+
+namespace
+{
+constexpr std::size_t N = 4096;
+
+template<typename _T>
+const std::array<_T, N> &input()
+{
+    static const auto values = [] {
+        std::array<_T, N> a{};
+        for (std::size_t i = 0; i < N; ++i) {
+            a[i] = _T{static_cast<double>(i * 7919 % 1009 + 1)};
+        }
+        return a;
+    }();
+    return values;
+}
+
+// the same values, with the dimension only known at runtime
+template<typename _T>
+const std::array<si::dynamic_unit, N> &dynamic_input()
+{
+    static const auto values = [] {
+        std::array<si::dynamic_unit, N> a{};
+        for (std::size_t i = 0; i < N; ++i) a[i] = input<_T>()[i];
+        return a;
+    }();
+    return values;
+}
+
+template<typename _Lhs, typename _Rhs, typename _Op>
+void bench_static(si_bench::state &state, _Op op)
+{
+    const auto &a = input<_Lhs>();
+    const auto &b = input<_Rhs>();
+    std::array<decltype(op(a[0], b[0])), N> out;
+    state.set_items_per_iteration(N);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        for (std::size_t j = 0; j < N; ++j) out[j] = op(a[j], b[j]);
+        si_bench::do_not_optimize(out.data());
+    }
+}
+
+template<typename _Lhs, typename _Rhs, typename _Op>
+void bench_dynamic(si_bench::state &state, _Op op)
+{
+    const auto &a = dynamic_input<_Lhs>();
+    const auto &b = dynamic_input<_Rhs>();
+    std::array<decltype(op(a[0], b[0])), N> out;
+    state.set_items_per_iteration(N);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        for (std::size_t j = 0; j < N; ++j) out[j] = op(a[j], b[j]);
+        si_bench::do_not_optimize(out.data());
+    }
+}
+
+using m  = si::length<double>;
+using mm = si::length<double, std::milli>;
+using s  = si::time<double>;
+using dyn = si::dynamic_unit;
+} // namespace
+
+SI_BENCHMARK("dynamic/m + mm", "static") { bench_static<m, mm>(state, [](m a, mm b) { return a + b; }); }
+SI_BENCHMARK("dynamic/m + mm", "dynamic") { bench_dynamic<m, mm>(state, [](const dyn &a, const dyn &b) { return a + b; }); }
+
+SI_BENCHMARK("dynamic/m / s", "static") { bench_static<m, s>(state, [](m a, s b) { return a / b; }); }
+SI_BENCHMARK("dynamic/m / s", "dynamic") { bench_dynamic<m, s>(state, [](const dyn &a, const dyn &b) { return a / b; }); }
+
+SI_BENCHMARK("dynamic/m < mm", "static") { bench_static<m, mm>(state, [](m a, mm b) { return a < b; }); }
+SI_BENCHMARK("dynamic/m < mm", "dynamic") { bench_dynamic<m, mm>(state, [](const dyn &a, const dyn &b) { return a < b; }); }
+
+SI_BENCHMARK("dynamic/to static", "unit_cast") { bench_static<mm, mm>(state, [](mm a, mm) { return si::unit_cast<m>(a); }); }
+SI_BENCHMARK("dynamic/to static", "dynamic unit_cast")
+{
+    bench_dynamic<mm, mm>(state, [](const dyn &a, const dyn &) {
+        m out;
+        return si::unit_cast(a, out) == si::dynamic_errc::ok ? out : m{};
+    });
+}
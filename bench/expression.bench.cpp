@@ -0,0 +1,82 @@
+#include "bench.hpp"
+
+#include "si/expression.hpp"
+#include "si/units.hpp"
+
+#include <vector>
+
+namespace
+{
+constexpr std::size_t N = 1 << 16;
+
+using force_t  = si::force<double>;
+using length_t = si::length<double>;
+using energy_t = si::energy<double>;
+
+struct operands
+{
+    si::unit_vector<force_t> force;
+    si::unit_vector<length_t> distance;
+    si::unit_vector<energy_t> other;
+
+    operands()
+    {
+        for (std::size_t i = 0; i < N; ++i) {
+            force.emplace_back(i % 101);
+            distance.emplace_back(i % 53);
+            other.emplace_back(i % 7);
+        }
+    }
+};
+
+const operands &input()
+{
+    static const operands values;
+    return values;
+}
+
+constexpr std::size_t bytes = N * 4 * sizeof(double);
+} // namespace
+
+SI_BENCHMARK("expression/f*d+e", "raw double loop")
+{
+    const auto &in = input();
+    std::vector<double> out(N);
+    state.set_items_per_iteration(N);
+    state.set_bytes_per_iteration(bytes);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        const double *f = in.force.data(), *d = in.distance.data(), *e = in.other.data();
+        for (std::size_t j = 0; j < N; ++j) out[j] = f[j] * d[j] + e[j];
+        si_bench::do_not_optimize(out.data());
+    }
+}
+
+// one pass and one temporary array per operator, as when applying the unit operators
+// over whole arrays
+SI_BENCHMARK("expression/f*d+e", "eager, per operator")
+{
+    const auto &in = input();
+    std::vector<energy_t> tmp(N), out(N);
+    state.set_items_per_iteration(N);
+    state.set_bytes_per_iteration(bytes);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        for (std::size_t j = 0; j < N; ++j) tmp[j] = in.force[j] * in.distance[j];
+        for (std::size_t j = 0; j < N; ++j) out[j] = tmp[j] + in.other[j];
+        si_bench::do_not_optimize(out.data());
+    }
+}
+
+SI_BENCHMARK("expression/f*d+e", "fused expression")
+{
+    const auto &in = input();
+    si::unit_vector<energy_t> out(N);
+    state.set_items_per_iteration(N);
+    state.set_bytes_per_iteration(bytes);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        si::assign(out, in.force * in.distance + in.other);
+        si_bench::do_not_optimize(out.data());
+    }
+}
@@ -0,0 +1,95 @@
+#include "bench.hpp"
+
+#include "si/fixed.hpp"
+#include "si/units.hpp"
+
+#include <array>
+#include <cstdint>
+
+// Fixed point against floating point representations, for the derived unit operators
+// and for conversions between prefixes. The fixed point loops matter on cores without
+// a fast floating point unit; with one, they show what the rounded shifts and the
+// integer division of the quotients cost.
+namespace
+{
+constexpr std::size_t N = 4096;
+
+using q16 = si::fixed<std::int32_t, 16>;
+using q16_down = si::fixed<std::int32_t, 16, si::rounding::down>;
+
+template<typename _T>
+const std::array<_T, N> &input()
+{
+    static const auto values = [] {
+        std::array<_T, N> a{};
+        for (std::size_t i = 0; i < N; ++i) {
+            a[i] = _T{typename _T::rep{static_cast<float>(i * 7919 % 1009 + 1) / 16}};
+        }
+        return a;
+    }();
+    return values;
+}
+
+template<typename _Lhs, typename _Rhs, typename _Out, typename _Op>
+void binary_kernel(const _Lhs *__restrict a, const _Rhs *__restrict b, _Out *__restrict out, _Op op)
+{
+    for (std::size_t j = 0; j < N; ++j) out[j] = op(a[j], b[j]);
+}
+
+template<typename _Lhs, typename _Rhs, typename _Op>
+void bench_binary(si_bench::state &state, _Op op)
+{
+    const auto &a = input<_Lhs>();
+    const auto &b = input<_Rhs>();
+    std::array<decltype(op(a[0], b[0])), N> out;
+    state.set_items_per_iteration(N);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        binary_kernel(a.data(), b.data(), out.data(), op);
+        si_bench::do_not_optimize(out.data());
+    }
+}
+
+template<typename _To, typename _From>
+void bench_cast(si_bench::state &state)
+{
+    const auto &a = input<_From>();
+    std::array<_To, N> out;
+    state.set_items_per_iteration(N);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        for (std::size_t j = 0; j < N; ++j) out[j] = si::unit_cast<_To>(a[j]);
+        si_bench::do_not_optimize(out.data());
+    }
+}
+
+template<typename _Rep>
+void bench_force_length(si_bench::state &state)
+{
+    bench_binary<si::force<_Rep>, si::length<_Rep>>(state, [](auto f, auto l) { return f * l; });
+}
+
+template<typename _Rep>
+void bench_energy_time(si_bench::state &state)
+{
+    bench_binary<si::energy<_Rep>, si::time<_Rep>>(state, [](auto e, auto t) { return e / t; });
+}
+
+template<typename _Rep>
+void bench_mm_to_m(si_bench::state &state)
+{
+    bench_cast<si::length<_Rep>, si::length<_Rep, std::milli>>(state);
+}
+} // namespace
+
+SI_BENCHMARK("fixed/force * length", "float") { bench_force_length<float>(state); }
+SI_BENCHMARK("fixed/force * length", "fixed<int32_t, 16>") { bench_force_length<q16>(state); }
+SI_BENCHMARK("fixed/force * length", "fixed<int32_t, 16> round down") { bench_force_length<q16_down>(state); }
+
+SI_BENCHMARK("fixed/energy / time", "float") { bench_energy_time<float>(state); }
+SI_BENCHMARK("fixed/energy / time", "fixed<int32_t, 16>") { bench_energy_time<q16>(state); }
+SI_BENCHMARK("fixed/energy / time", "fixed<int32_t, 16> round down") { bench_energy_time<q16_down>(state); }
+
+SI_BENCHMARK("fixed/mm -> m", "float") { bench_mm_to_m<float>(state); }
+SI_BENCHMARK("fixed/mm -> m", "fixed<int32_t, 16>") { bench_mm_to_m<q16>(state); }
+SI_BENCHMARK("fixed/mm -> m", "fixed<int32_t, 16> round down") { bench_mm_to_m<q16_down>(state); }
@@ -0,0 +1,94 @@
+#include "bench.hpp"
+
+#include "si/lut.hpp"
+#include "si/units.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+// Calibrating temperatures into voltages through a table of 64 entries. The baseline
+// searches a table of raw doubles for every input, as tables of arbitrary spacing have
+// to, then si::lut one input at a time and over the whole array.
+namespace
+{
+constexpr std::size_t N = 1 << 14;
+constexpr std::size_t entries = 64;
+
+using millikelvin = si::temperature<float, std::milli>;
+using millivolt   = si::voltage<double, std::milli>;
+using table_type  = si::lut<si::temperature<double>, millivolt, entries>;
+
+struct fixture
+{
+    std::vector<millikelvin> in;
+    std::vector<millivolt> out = std::vector<millivolt>(N);
+    std::array<double, entries> xs;
+    std::array<double, entries> ys;
+    std::array<millivolt, entries> values;
+
+    fixture()
+    {
+        for (std::size_t i = 0; i < entries; ++i) {
+            xs[i] = 250.0 + i;
+            ys[i] = std::sqrt(xs[i]);
+            values[i] = millivolt{ys[i]};
+        }
+        for (std::size_t i = 0; i < N; ++i) in.emplace_back(static_cast<float>(250000 + i * 7919 % 63000));
+    }
+};
+
+template<typename _Evaluate>
+void bench_lut(si_bench::state &state, _Evaluate evaluate)
+{
+    fixture f;
+    const table_type table{si::temperature<double>{250}, si::temperature<double>{250 + entries - 1}, f.values};
+    state.set_items_per_iteration(N);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        evaluate(f, table);
+        si_bench::do_not_optimize(f.out.data());
+    }
+}
+
+void searched(si_bench::state &state)
+{
+    bench_lut(state, [](fixture &f, const table_type &) {
+        auto *out = reinterpret_cast<double *>(f.out.data());
+        for (std::size_t i = 0; i < N; ++i) {
+            const double x = f.in[i].count() * 1e-3;
+            const auto upper = std::upper_bound(f.xs.begin() + 1, f.xs.end() - 1, x);
+            const auto j = static_cast<std::size_t>(upper - f.xs.begin()) - 1;
+            const double t = (x - f.xs[j]) / (f.xs[j + 1] - f.xs[j]);
+            out[i] = f.ys[j] + t * (f.ys[j + 1] - f.ys[j]);
+        }
+    });
+}
+
+void scalar(si_bench::state &state)
+{
+    bench_lut(state, [](fixture &f, const table_type &table) {
+        for (std::size_t i = 0; i < N; ++i) f.out[i] = table(f.in[i]);
+    });
+}
+
+void batch(si_bench::state &state)
+{
+    bench_lut(state, [](fixture &f, const table_type &table) {
+        table.linear(si::span<const millikelvin>{f.in}, si::span<millivolt>{f.out});
+    });
+}
+
+void batch_cubic(si_bench::state &state)
+{
+    bench_lut(state, [](fixture &f, const table_type &table) {
+        table.cubic(si::span<const millikelvin>{f.in}, si::span<millivolt>{f.out});
+    });
+}
+} // namespace
+
+SI_BENCHMARK("lut/64 entries", "raw double, binary search") { searched(state); }
+SI_BENCHMARK("lut/64 entries", "si::lut linear, one by one") { scalar(state); }
+SI_BENCHMARK("lut/64 entries", "si::lut linear, array") { batch(state); }
+SI_BENCHMARK("lut/64 entries", "si::lut cubic, array") { batch_cubic(state); }
@@ -0,0 +1,78 @@
+#include "bench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+using steady_clock = std::chrono::steady_clock;
+
+constexpr auto min_run_time = std::chrono::milliseconds(100);
+constexpr int repetitions = 3;
+
+double run_once(const si_bench::benchmark &b, std::size_t iterations, si_bench::state &st)
+{
+    st = si_bench::state{iterations};
+    const auto start = steady_clock::now();
+    b.fn(st);
+    const auto stop = steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count();
+}
+
+// best time per iteration, in nanoseconds
+double measure(const si_bench::benchmark &b, si_bench::state &st)
+{
+    std::size_t iterations = 1;
+    double elapsed = run_once(b, iterations, st);
+    if (st.skipped()) return 0;
+
+    while (elapsed < std::chrono::duration<double, std::nano>(min_run_time).count()) {
+        iterations *= elapsed > 0 ? std::max<std::size_t>(2, min_run_time.count() * 1e6 / elapsed) : 10;
+        elapsed = run_once(b, iterations, st);
+    }
+
+    double best = elapsed / iterations;
+    for (int i = 1; i < repetitions; ++i) {
+        best = std::min(best, run_once(b, iterations, st) / iterations);
+    }
+    return best;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const char *filter = argc > 1 ? argv[1] : "";
+
+    std::string group;
+    double baseline = 0;
+
+    std::printf("%-24s %-40s %12s %12s %12s %10s\n",
+                "group", "benchmark", "ns/item", "Mitems/s", "MB/s", "relative");
+    for (const auto &b : si_bench::registry()) {
+        const auto full_name = std::string(b.group) + "/" + b.name;
+        if (full_name.find(filter) == std::string::npos) continue;
+
+        si_bench::state st{1};
+        const double ns_per_iteration = measure(b, st);
+        if (st.skipped()) {
+            std::printf("%-24s %-40s %12s\n", b.group, b.name, "skipped");
+            continue;
+        }
+        const double ns_per_item = ns_per_iteration / st.items_per_iteration();
+
+        if (group != b.group) {
+            group = b.group;
+            baseline = ns_per_item;
+        }
+
+        std::printf("%-24s %-40s %12.3f %12.1f ", b.group, b.name, ns_per_item, 1e3 / ns_per_item);
+        if (st.bytes_per_iteration() != 0) {
+            std::printf("%12.1f ", st.bytes_per_iteration() * 1e3 / ns_per_iteration);
+        } else {
+            std::printf("%12s ", "-");
+        }
+        std::printf("%9.2fx\n", ns_per_item / baseline);
+    }
+}
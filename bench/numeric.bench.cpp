@@ -0,0 +1,115 @@
+#include "bench.hpp"
+
+#include "si/numeric.hpp"
+#include "si/units.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// Reductions of a million units: the loop with operator+ people write today, against
+// si::sum, sequential and with a parallel policy, and a naive dot product against si::dot.
+namespace
+{
+constexpr std::size_t N = 1 << 20;
+
+template<typename _Unit>
+const std::vector<_Unit> &input()
+{
+    static const auto values = [] {
+        std::vector<_Unit> v;
+        for (std::size_t i = 0; i < N; ++i) v.emplace_back(static_cast<typename _Unit::rep>(i * 7919 % 1009 + 1));
+        return v;
+    }();
+    return values;
+}
+
+template<typename _Unit, typename _Reduce>
+void bench_reduce(si_bench::state &state, _Reduce reduce)
+{
+    const auto &a = input<_Unit>();
+    state.set_items_per_iteration(N);
+    state.set_bytes_per_iteration(N * sizeof(_Unit));
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        auto result = reduce(a);
+        si_bench::do_not_optimize(&result);
+    }
+}
+
+template<typename _Unit>
+void sum_naive(si_bench::state &state)
+{
+    bench_reduce<_Unit>(state, [](const auto &a) {
+        _Unit total{0};
+        for (const auto &x : a) total += x;
+        return total;
+    });
+}
+
+template<typename _Unit>
+void sum_si(si_bench::state &state)
+{
+    bench_reduce<_Unit>(state, [](const auto &a) { return si::sum(a); });
+}
+
+#if SI_HAS_EXECUTION
+template<typename _Unit>
+void sum_si_par(si_bench::state &state)
+{
+    bench_reduce<_Unit>(state, [](const auto &a) { return si::sum(std::execution::par, a); });
+}
+#endif
+
+void dot_naive(si_bench::state &state)
+{
+    const auto &l = input<si::length<float>>();
+    bench_reduce<si::force<float>>(state, [&](const auto &f) {
+        si::energy<float> total{0};
+        for (std::size_t j = 0; j < N; ++j) total += f[j] * l[j];
+        return total;
+    });
+}
+
+void dot_si(si_bench::state &state)
+{
+    const auto &l = input<si::length<float>>();
+    bench_reduce<si::force<float>>(state, [&](const auto &f) { return si::dot(f, l); });
+}
+
+template<typename _Unit>
+void min_max_naive(si_bench::state &state)
+{
+    bench_reduce<_Unit>(state, [](const auto &a) {
+        auto extremes = si::min_max_result<_Unit>{a[0], a[0]};
+        for (const auto &x : a) {
+            if (x < extremes.min) extremes.min = x;
+            if (extremes.max < x) extremes.max = x;
+        }
+        return extremes;
+    });
+}
+
+template<typename _Unit>
+void min_max_si(si_bench::state &state)
+{
+    bench_reduce<_Unit>(state, [](const auto &a) { return si::min_max(a); });
+}
+} // namespace
+
+SI_BENCHMARK("sum/energy<float>", "operator+") { sum_naive<si::energy<float>>(state); }
+SI_BENCHMARK("sum/energy<float>", "si::sum") { sum_si<si::energy<float>>(state); }
+#if SI_HAS_EXECUTION
+SI_BENCHMARK("sum/energy<float>", "si::sum par") { sum_si_par<si::energy<float>>(state); }
+#endif
+
+SI_BENCHMARK("sum/energy<double>", "operator+") { sum_naive<si::energy<double>>(state); }
+SI_BENCHMARK("sum/energy<double>", "si::sum") { sum_si<si::energy<double>>(state); }
+
+SI_BENCHMARK("sum/length<int32_t>", "operator+") { sum_naive<si::length<std::int32_t>>(state); }
+SI_BENCHMARK("sum/length<int32_t>", "si::sum") { sum_si<si::length<std::int32_t>>(state); }
+
+SI_BENCHMARK("dot/force * length<float>", "operator*") { dot_naive(state); }
+SI_BENCHMARK("dot/force * length<float>", "si::dot") { dot_si(state); }
+
+SI_BENCHMARK("min_max/length<float>", "operator<") { min_max_naive<si::length<float>>(state); }
+SI_BENCHMARK("min_max/length<float>", "si::min_max") { min_max_si<si::length<float>>(state); }
@@ -0,0 +1,204 @@
+#include "bench.hpp"
+
+#include "si/units.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ratio>
+#include <tuple>
+
+// The cost of si::unit against the same arithmetic written by hand on raw numbers,
+// for every representation. Each group has the raw loop as its baseline, so any
+// relative time above 1.00x is overhead introduced by the library.
+namespace
+{
+constexpr std::size_t N = 4096;
+
+template<typename _Rep>
+_Rep raw_value(std::size_t i)
+{
+    // never zero, so that everything can be divided by it
+    return static_cast<_Rep>(i * 7919 % 1009 + 1);
+}
+
+// N values of _T, either a raw representation or a unit built from one
+template<typename _T, typename = void>
+struct make_value
+{
+    static _T at(std::size_t i) { return raw_value<_T>(i); }
+};
+
+template<typename _T>
+struct make_value<_T, std::void_t<typename _T::rep>>
+{
+    static _T at(std::size_t i) { return _T{raw_value<typename _T::rep>(i)}; }
+};
+
+template<typename _T, int _Seed = 0>
+const std::array<_T, N> &input()
+{
+    static const auto values = [] {
+        std::array<_T, N> a{};
+        for (std::size_t i = 0; i < N; ++i) {
+            a[i] = make_value<_T>::at(i * (_Seed + 1) + _Seed);
+        }
+        return a;
+    }();
+    return values;
+}
+
+// The raw and the unit loops go through the same kernels, so that the compiler knows
+// as much about aliasing in both and the comparison is only about the arithmetic.
+template<typename _In, typename _Out, typename _Op>
+void unary_kernel(const _In *__restrict a, _Out *__restrict out, _Op op)
+{
+    for (std::size_t j = 0; j < N; ++j) out[j] = op(a[j]);
+}
+
+template<typename _Lhs, typename _Rhs, typename _Out, typename _Op>
+void binary_kernel(const _Lhs *__restrict a, const _Rhs *__restrict b, _Out *__restrict out, _Op op)
+{
+    for (std::size_t j = 0; j < N; ++j) out[j] = op(a[j], b[j]);
+}
+
+template<typename _In, typename _Op>
+void bench_unary(si_bench::state &state, _Op op)
+{
+    const auto &a = input<_In>();
+    std::array<decltype(op(a[0])), N> out;
+    state.set_items_per_iteration(N);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        unary_kernel(a.data(), out.data(), op);
+        si_bench::do_not_optimize(out.data());
+    }
+}
+
+template<typename _Lhs, typename _Rhs, typename _Op>
+void bench_binary(si_bench::state &state, _Op op)
+{
+    const auto &a = input<_Lhs>();
+    const auto &b = input<_Rhs, 1>();
+    std::array<decltype(op(a[0], b[0])), N> out;
+    state.set_items_per_iteration(N);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        binary_kernel(a.data(), b.data(), out.data(), op);
+        si_bench::do_not_optimize(out.data());
+    }
+}
+
+// converting from the unprefixed unit to the unit of _Ratio, by hand: a single
+// multiplication or division for integers, a folded factor for floating point
+template<typename _Rep, typename _Ratio>
+_Rep raw_prefix_cast(_Rep value)
+{
+    if constexpr (!std::is_integral<_Rep>::value) {
+        return value * (static_cast<_Rep>(_Ratio::den) / static_cast<_Rep>(_Ratio::num));
+    } else if constexpr (_Ratio::num == 1) {
+        return static_cast<_Rep>(value * _Ratio::den);
+    } else {
+        return static_cast<_Rep>(value / _Ratio::num);
+    }
+}
+
+using prefixes = std::tuple<std::atto, std::femto, std::pico, std::nano, std::micro, std::milli,
+                            std::centi, std::deci, std::ratio<1>, std::deca, std::hecto, std::kilo,
+                            std::mega, std::giga, std::tera, std::peta, std::exa>;
+
+constexpr std::size_t prefix_count = std::tuple_size<prefixes>::value;
+
+// every value converted to every prefix, one pass per prefix
+template<typename _Rep, typename _Cast>
+void bench_prefixes(si_bench::state &state, _Cast cast)
+{
+    const auto &a = input<_Rep>();
+    std::array<_Rep, N> out;
+    state.set_items_per_iteration(N * prefix_count);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        std::apply([&](auto... ratios) {
+            ((unary_kernel(a.data(), out.data(), [&](_Rep v) { return cast(v, ratios); }),
+              si_bench::do_not_optimize(out.data())), ...);
+        }, prefixes{});
+    }
+}
+
+template<typename _Rep>
+void prefixes_raw(si_bench::state &state)
+{
+    bench_prefixes<_Rep>(state, [](_Rep v, auto ratio) {
+        return raw_prefix_cast<_Rep, decltype(ratio)>(v);
+    });
+}
+
+template<typename _Rep>
+void prefixes_unit_cast(si_bench::state &state)
+{
+    bench_prefixes<_Rep>(state, [](_Rep v, auto ratio) {
+        return si::unit_cast<si::length<_Rep, decltype(ratio)>>(si::length<_Rep>{v}).count();
+    });
+}
+
+template<typename _Rep> using m  = si::length<_Rep>;
+template<typename _Rep> using mm = si::length<_Rep, std::milli>;
+template<typename _Rep> using s  = si::time<_Rep>;
+} // namespace
+
+#define SI_OVERHEAD_BENCHMARKS(rep, name)                                                            \
+    SI_BENCHMARK("construct/" name, "raw copy")                                                      \
+    { bench_unary<rep>(state, [](rep a) { return a; }); }                                            \
+    SI_BENCHMARK("construct/" name, "unit{rep}")                                                     \
+    { bench_unary<rep>(state, [](rep a) { return m<rep>{a}; }); }                                    \
+                                                                                                     \
+    SI_BENCHMARK("m + mm/" name, "raw a * 1000 + b")                                                 \
+    { bench_binary<rep, rep>(state, [](rep a, rep b) { return static_cast<rep>(a * 1000 + b); }); }  \
+    SI_BENCHMARK("m + mm/" name, "unit m + mm")                                                      \
+    { bench_binary<m<rep>, mm<rep>>(state, [](m<rep> a, mm<rep> b) { return a + b; }); }             \
+                                                                                                     \
+    SI_BENCHMARK("m - mm/" name, "raw a * 1000 - b")                                                 \
+    { bench_binary<rep, rep>(state, [](rep a, rep b) { return static_cast<rep>(a * 1000 - b); }); }  \
+    SI_BENCHMARK("m - mm/" name, "unit m - mm")                                                      \
+    { bench_binary<m<rep>, mm<rep>>(state, [](m<rep> a, mm<rep> b) { return a - b; }); }             \
+                                                                                                     \
+    SI_BENCHMARK("m < mm/" name, "raw a * 1000 < b")                                                 \
+    { bench_binary<rep, rep>(state, [](rep a, rep b) { return a * 1000 < b; }); }                    \
+    SI_BENCHMARK("m < mm/" name, "unit m < mm")                                                      \
+    { bench_binary<m<rep>, mm<rep>>(state, [](m<rep> a, mm<rep> b) { return a < b; }); }             \
+                                                                                                     \
+    SI_BENCHMARK("m == mm/" name, "raw a * 1000 == b")                                               \
+    { bench_binary<rep, rep>(state, [](rep a, rep b) { return a * 1000 == b; }); }                   \
+    SI_BENCHMARK("m == mm/" name, "unit m == mm")                                                    \
+    { bench_binary<m<rep>, mm<rep>>(state, [](m<rep> a, mm<rep> b) { return a == b; }); }            \
+                                                                                                     \
+    SI_BENCHMARK("m * m/" name, "raw a * b")                                                         \
+    { bench_binary<rep, rep>(state, [](rep a, rep b) { return static_cast<rep>(a * b); }); }         \
+    SI_BENCHMARK("m * m/" name, "unit length * length")                                              \
+    { bench_binary<m<rep>, m<rep>>(state, [](m<rep> a, m<rep> b) { return a * b; }); }               \
+                                                                                                     \
+    SI_BENCHMARK("m / s/" name, "raw a / b")                                                         \
+    { bench_binary<rep, rep>(state, [](rep a, rep b) { return static_cast<rep>(a / b); }); }         \
+    SI_BENCHMARK("m / s/" name, "unit length / time")                                                \
+    { bench_binary<m<rep>, s<rep>>(state, [](m<rep> a, s<rep> b) { return a / b; }); }              \
+                                                                                                     \
+    SI_BENCHMARK("chrono/" name, "raw duration<ms>{a * 1000}")                                       \
+    {                                                                                                \
+        bench_unary<rep>(state, [](rep a) {                                                          \
+            return std::chrono::duration<rep, std::milli>{static_cast<rep>(a * 1000)};               \
+        });                                                                                          \
+    }                                                                                                \
+    SI_BENCHMARK("chrono/" name, "unit s to duration<ms>")                                           \
+    {                                                                                                \
+        bench_unary<s<rep>>(state, [](s<rep> a) {                                                    \
+            return static_cast<std::chrono::duration<rep, std::milli>>(a);                           \
+        });                                                                                          \
+    }                                                                                                \
+                                                                                                     \
+    SI_BENCHMARK("prefixes/" name, "raw, every prefix") { prefixes_raw<rep>(state); }                \
+    SI_BENCHMARK("prefixes/" name, "unit_cast, every prefix") { prefixes_unit_cast<rep>(state); }
+
+SI_OVERHEAD_BENCHMARKS(int, "int")
+SI_OVERHEAD_BENCHMARKS(int64_t, "int64")
+SI_OVERHEAD_BENCHMARKS(float, "float")
+SI_OVERHEAD_BENCHMARKS(double, "double")
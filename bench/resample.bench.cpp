@@ -0,0 +1,91 @@
+#include "bench.hpp"
+
+#include "si/resample.hpp"
+#include "si/units.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Downsampling a stream of pressure samples every millisecond into buckets of 250 ms.
+// The baseline buckets raw doubles by hand, in order and without the integral, then
+// si::resampler in order and with samples shuffled within a tolerance of 20 ms.
+namespace
+{
+constexpr std::size_t N = 1 << 16;
+
+using pressure  = si::pressure<double>;
+using timestamp = si::time<std::int64_t, std::nano>;
+
+struct stream
+{
+    std::vector<std::int64_t> times;
+    std::vector<double> values;
+
+    explicit stream(bool shuffled)
+    {
+        for (std::size_t i = 0; i < N; ++i) {
+            // every block of eight milliseconds arrives backwards
+            const auto j = shuffled ? (i - i % 8) + 7 - i % 8 : i;
+            times.push_back(static_cast<std::int64_t>(j) * 1000000);
+            values.push_back(static_cast<double>(j % 1013));
+        }
+    }
+};
+
+struct raw_bucket
+{
+    std::size_t count;
+    double sum, min, max, last;
+};
+
+void raw(si_bench::state &state)
+{
+    const stream s{false};
+    const std::int64_t width = 250000000;
+    std::vector<raw_bucket> out;
+    out.reserve(N);
+    state.set_items_per_iteration(N);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        out.clear();
+        raw_bucket b{};
+        std::int64_t current = s.times[0] / width;
+        for (std::size_t j = 0; j < N; ++j) {
+            const auto k = s.times[j] / width;
+            if (k != current) {
+                out.push_back(b);
+                b = raw_bucket{};
+                current = k;
+            }
+            const auto v = s.values[j];
+            b.min = b.count == 0 ? v : std::min(b.min, v);
+            b.max = b.count == 0 ? v : std::max(b.max, v);
+            b.last = v;
+            b.sum += v;
+            ++b.count;
+        }
+        out.push_back(b);
+        si_bench::do_not_optimize(out.data());
+    }
+}
+
+void resampled(si_bench::state &state, bool shuffled)
+{
+    const stream s{shuffled};
+    std::vector<si::bucket<pressure>> out;
+    out.reserve(N);
+    state.set_items_per_iteration(N);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        out.clear();
+        si::resampler<pressure> resampler{si::millisecond{250}, si::millisecond{shuffled ? 20 : 0}};
+        auto sink = [&](const si::bucket<pressure> &b) { out.push_back(b); };
+        for (std::size_t j = 0; j < N; ++j) resampler.push(timestamp{s.times[j]}, pressure{s.values[j]}, sink);
+        resampler.flush(sink);
+        si_bench::do_not_optimize(out.data());
+    }
+}
+} // namespace
+
+SI_BENCHMARK("resample/250 ms buckets", "raw double, no integral") { raw(state); }
+SI_BENCHMARK("resample/250 ms buckets", "si::resampler") { resampled(state, false); }
+SI_BENCHMARK("resample/250 ms buckets", "si::resampler, out of order") { resampled(state, true); }
@@ -0,0 +1,90 @@
+#include "bench.hpp"
+
+#include "si/simd.hpp"
+#include "si/units.hpp"
+
+#include <algorithm>
+#include <vector>
+
+// One step of a kinematics kernel over arrays of particles: accelerate, clamp to a
+// speed limit and move. The baseline is the loop on raw doubles, then the same loop
+// on scalar units and on units of std::experimental::native_simd<double>.
+#if SI_HAS_SIMD
+namespace
+{
+constexpr std::size_t N = 1 << 14;
+
+using pack = std::experimental::native_simd<double>;
+
+struct particles
+{
+    std::vector<si::length<double>> x = std::vector<si::length<double>>(N);
+    std::vector<si::velocity<double>> v = std::vector<si::velocity<double>>(N);
+    std::vector<si::acceleration<double>> a;
+
+    particles()
+    {
+        for (std::size_t i = 0; i < N; ++i) a.emplace_back(static_cast<double>(i % 97) - 48.0);
+    }
+};
+
+template<typename _Step>
+void bench_step(si_bench::state &state, _Step step)
+{
+    particles p;
+    state.set_items_per_iteration(N);
+    state.set_bytes_per_iteration(N * 3 * sizeof(double));
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        step(p);
+        si_bench::do_not_optimize(p.x.data());
+    }
+}
+
+void raw(si_bench::state &state)
+{
+    bench_step(state, [](particles &p) {
+        auto *x = reinterpret_cast<double *>(p.x.data());
+        auto *v = reinterpret_cast<double *>(p.v.data());
+        const auto *a = reinterpret_cast<const double *>(p.a.data());
+        const double dt = 1e-3, limit = 30.0;
+        for (std::size_t i = 0; i < N; ++i) {
+            v[i] = std::min(v[i] + a[i] * dt, limit);
+            x[i] += v[i] * dt;
+        }
+    });
+}
+
+void scalar_units(si_bench::state &state)
+{
+    bench_step(state, [](particles &p) {
+        const si::time<double, std::milli> dt{1.0};
+        const si::velocity<double> limit{30.0};
+        for (std::size_t i = 0; i < N; ++i) {
+            p.v[i] = std::min<si::velocity<double>>(p.v[i] + p.a[i] * dt, limit);
+            p.x[i] += p.v[i] * dt;
+        }
+    });
+}
+
+void pack_units(si_bench::state &state)
+{
+    bench_step(state, [](particles &p) {
+        const si::time<pack, std::milli> dt = si::time<double, std::milli>{1.0};
+        const si::velocity<pack> limit = si::velocity<double>{30.0};
+        for (std::size_t i = 0; i < N; i += pack::size()) {
+            const si::velocity<pack> accelerated = si::load_pack<pack>(&p.v[i]) + si::load_pack<pack>(&p.a[i]) * dt;
+            auto counts = accelerated.count();
+            std::experimental::where(accelerated > limit, counts) = limit.count();
+            const si::velocity<pack> v{counts};
+            si::store_pack(v, &p.v[i]);
+            si::store_pack(si::load_pack<pack>(&p.x[i]) + v * dt, &p.x[i]);
+        }
+    });
+}
+} // namespace
+
+SI_BENCHMARK("simd/kinematics step", "raw double") { raw(state); }
+SI_BENCHMARK("simd/kinematics step", "si::unit<double>") { scalar_units(state); }
+SI_BENCHMARK("simd/kinematics step", "si::unit<native_simd<double>>") { pack_units(state); }
+#endif
@@ -0,0 +1,123 @@
+#include "bench.hpp"
+
+#include "si/units.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace
+{
+// unit_cast as it was before the conversion paths were specialised, always
+// multiplying by num and dividing by den at runtime
+template<typename _ToUnit, typename _Rep, typename _Ratio, typename _Base>
+_ToUnit legacy_unit_cast(const si::unit<_Rep, _Ratio, _Base> &other)
+{
+    using to_ratio   = typename _ToUnit::ratio;
+    using to_rep     = typename _ToUnit::rep;
+    using ratio_tf   = std::ratio_divide<_Ratio, to_ratio>;
+    using common_rep = typename std::common_type_t<_Rep, to_rep>;
+
+    auto v = static_cast<common_rep>(other.count()
+            * static_cast<common_rep>(ratio_tf::num)
+            / static_cast<common_rep>(ratio_tf::den));
+    return _ToUnit{static_cast<to_rep>(v)};
+}
+
+constexpr std::size_t N = 4096;
+
+template <typename _From>
+const std::array<_From, N> &input()
+{
+    static const auto values = [] {
+        std::array<_From, N> a{};
+        for (std::size_t i = 0; i < N; ++i) {
+            a[i] = _From{static_cast<typename _From::rep>(i * 7919 % 100003)};
+        }
+        return a;
+    }();
+    return values;
+}
+
+template <typename _To, typename _From>
+void bench_legacy(si_bench::state &state)
+{
+    const auto &in = input<_From>();
+    std::array<_To, N> out;
+    state.set_items_per_iteration(N);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        for (std::size_t j = 0; j < N; ++j) {
+            out[j] = legacy_unit_cast<_To>(in[j]);
+        }
+        si_bench::do_not_optimize(out);
+    }
+}
+
+template <typename _To, typename _From, typename... _Policy>
+void bench_unit_cast(si_bench::state &state, _Policy... policy)
+{
+    const auto &in = input<_From>();
+    std::array<_To, N> out;
+    state.set_items_per_iteration(N);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        for (std::size_t j = 0; j < N; ++j) {
+            out[j] = si::unit_cast<_To>(in[j], policy...);
+        }
+        si_bench::do_not_optimize(out);
+    }
+}
+
+template <typename _To, typename _From>
+void bench_checked(si_bench::state &state)
+{
+    const auto &in = input<_From>();
+    std::array<_To, N> out;
+    state.set_items_per_iteration(N);
+    for (std::size_t i = 0; i < state.iterations(); ++i) {
+        si_bench::clobber();
+        bool overflow = false;
+        for (std::size_t j = 0; j < N; ++j) {
+            const auto r = si::unit_cast<_To>(in[j], si::checked);
+            out[j] = r.value;
+            overflow |= r.overflow;
+        }
+        si_bench::do_not_optimize(out);
+        si_bench::do_not_optimize(overflow);
+    }
+}
+
+using m_i    = si::length<int>;
+using mm_i   = si::length<int, std::milli>;
+using m_l    = si::length<int64_t>;
+using mm_l   = si::length<int64_t, std::milli>;
+using m_d    = si::length<double>;
+using mm_d   = si::length<double, std::milli>;
+using ft_l   = si::length<int64_t, std::ratio<3048, 10000>>;
+using s_l    = si::time<int64_t>;
+using ns_l   = si::time<int64_t, std::nano>;
+} // namespace
+
+SI_BENCHMARK("unit_cast/identity", "legacy int") { bench_legacy<m_l, m_i>(state); }
+SI_BENCHMARK("unit_cast/identity", "unit_cast int") { bench_unit_cast<m_l, m_i>(state); }
+
+SI_BENCHMARK("unit_cast/multiply", "legacy int") { bench_legacy<mm_i, m_i>(state); }
+SI_BENCHMARK("unit_cast/multiply", "unit_cast int") { bench_unit_cast<mm_i, m_i>(state); }
+
+SI_BENCHMARK("unit_cast/divide", "legacy int") { bench_legacy<m_i, mm_i>(state); }
+SI_BENCHMARK("unit_cast/divide", "unit_cast int") { bench_unit_cast<m_i, mm_i>(state); }
+SI_BENCHMARK("unit_cast/divide64", "legacy int64") { bench_legacy<m_l, mm_l>(state); }
+SI_BENCHMARK("unit_cast/divide64", "unit_cast int64") { bench_unit_cast<m_l, mm_l>(state); }
+
+SI_BENCHMARK("unit_cast/floating", "legacy double") { bench_legacy<m_d, mm_d>(state); }
+SI_BENCHMARK("unit_cast/floating", "unit_cast double") { bench_unit_cast<m_d, mm_d>(state); }
+
+SI_BENCHMARK("unit_cast/general", "legacy int64") { bench_legacy<m_l, ft_l>(state); }
+SI_BENCHMARK("unit_cast/general", "unit_cast int64") { bench_unit_cast<m_l, ft_l>(state); }
+
+SI_BENCHMARK("unit_cast/policy multiply64", "unit_cast int64") { bench_unit_cast<ns_l, s_l>(state); }
+SI_BENCHMARK("unit_cast/policy multiply64", "saturate int64") { bench_unit_cast<ns_l, s_l>(state, si::saturate); }
+SI_BENCHMARK("unit_cast/policy multiply64", "checked int64") { bench_checked<ns_l, s_l>(state); }
+SI_BENCHMARK("unit_cast/policy general", "unit_cast int64") { bench_unit_cast<m_l, ft_l>(state); }
+SI_BENCHMARK("unit_cast/policy general", "saturate int64") { bench_unit_cast<m_l, ft_l>(state, si::saturate); }
+SI_BENCHMARK("unit_cast/policy general", "checked int64") { bench_checked<m_l, ft_l>(state); }
@@ -0,0 +1,250 @@
+#pragma once
+
+#include "si/core.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+// Units that many threads update concurrently, such as global counters of consumed
+// energy or elapsed time.
+//
+// si::atomic_unit is std::atomic for a unit: integral counts are added with the native
+// fetch_add, other representations with a compare and swap loop. Units of another ratio
+// are converted with unit_cast first, under the same rules as unit::operator+=.
+//
+// si::sharded_atomic_unit spreads the additions of different threads over counters on
+// cache lines of their own, and sums them when read. Under heavy contention it scales
+// where a single counter has every thread wait for the same cache line, at the cost of
+// reads that are neither cheap nor a snapshot of a single instant.
+//
+//     si::atomic_unit<si::energy<double>> consumed;
+//     consumed.fetch_add(si::energy<double, std::kilo>{1.5});
+namespace si
+{
+template<typename _Unit>
+class atomic_unit
+{
+public:
+    using value_type = _Unit;
+    using rep        = typename _Unit::rep;
+
+    static constexpr bool is_always_lock_free = std::atomic<rep>::is_always_lock_free;
+
+    constexpr atomic_unit() noexcept
+        : _count(rep{0}) { }
+    constexpr atomic_unit(_Unit value) noexcept
+        : _count(value.count()) { }
+
+    atomic_unit(const atomic_unit &) = delete;
+    atomic_unit &operator=(const atomic_unit &) = delete;
+
+    bool is_lock_free() const noexcept { return _count.is_lock_free(); }
+
+    _Unit load(std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+        return _Unit{_count.load(order)};
+    }
+
+    void store(_Unit value, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        _count.store(value.count(), order);
+    }
+
+    _Unit exchange(_Unit value, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return _Unit{_count.exchange(value.count(), order)};
+    }
+
+    bool compare_exchange_weak(_Unit &expected, _Unit desired,
+                               std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        auto count = expected.count();
+        const bool exchanged = _count.compare_exchange_weak(count, desired.count(), order);
+        expected = _Unit{count};
+        return exchanged;
+    }
+
+    bool compare_exchange_strong(_Unit &expected, _Unit desired,
+                                 std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        auto count = expected.count();
+        const bool exchanged = _count.compare_exchange_strong(count, desired.count(), order);
+        expected = _Unit{count};
+        return exchanged;
+    }
+
+    // adds `arg`, converted once to this unit, and returns the previous value
+    template<typename _Rep2, typename _Ratio2,
+             class = std::enable_if_t<detail::converts_implicitly<_Rep2, rep>::value>>
+    _Unit fetch_add(const unit<_Rep2, _Ratio2, typename _Unit::base> &arg,
+                    std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        const rep delta = unit_cast<_Unit>(arg).count();
+        if constexpr (native_add) {
+            return _Unit{_count.fetch_add(delta, order)};
+        } else {
+            return update(order, [delta](rep count) { return static_cast<rep>(count + delta); });
+        }
+    }
+
+    template<typename _Rep2, typename _Ratio2,
+             class = std::enable_if_t<detail::converts_implicitly<_Rep2, rep>::value>>
+    _Unit fetch_sub(const unit<_Rep2, _Ratio2, typename _Unit::base> &arg,
+                    std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        const rep delta = unit_cast<_Unit>(arg).count();
+        if constexpr (native_add) {
+            return _Unit{_count.fetch_sub(delta, order)};
+        } else {
+            return update(order, [delta](rep count) { return static_cast<rep>(count - delta); });
+        }
+    }
+
+    // unlike those of si::unit, these return the new value rather than a reference
+    template<typename _Rep2, typename _Ratio2,
+             class = std::enable_if_t<detail::converts_implicitly<_Rep2, rep>::value>>
+    _Unit operator+=(const unit<_Rep2, _Ratio2, typename _Unit::base> &arg) noexcept
+    {
+        const auto delta = unit_cast<_Unit>(arg);
+        return _Unit{static_cast<rep>(fetch_add(delta).count() + delta.count())};
+    }
+
+    template<typename _Rep2, typename _Ratio2,
+             class = std::enable_if_t<detail::converts_implicitly<_Rep2, rep>::value>>
+    _Unit operator-=(const unit<_Rep2, _Ratio2, typename _Unit::base> &arg) noexcept
+    {
+        const auto delta = unit_cast<_Unit>(arg);
+        return _Unit{static_cast<rep>(fetch_sub(delta).count() - delta.count())};
+    }
+
+    operator _Unit() const noexcept { return load(); }
+
+private:
+    // std::is_integral rather than detail::is_integral_rep: std::atomic only has
+    // fetch_add for the types std::is_integral knows, so 128 bit integers take the loop
+    // outside the GNU dialects. Where fetch_add is not lock free it takes its lock once,
+    // which is still cheaper than a loop of compare and swaps under the same lock.
+    static constexpr bool native_add = std::is_integral<rep>::value;
+
+    // std::atomic has no fetch_add for floating point before C++20, and none at all
+    // for the other representations
+    template<typename _Op>
+    _Unit update(std::memory_order order, _Op op) noexcept
+    {
+        auto count = _count.load(std::memory_order_relaxed);
+        while (!_count.compare_exchange_weak(count, op(count), order, std::memory_order_relaxed)) {
+        }
+        return _Unit{count};
+    }
+
+    std::atomic<rep> _count;
+};
+
+namespace detail
+{
+// the size of a cache line on the cpus that matter, std::hardware_destructive_interference_size
+// is not reliably available and differs between the compilers of a single program
+constexpr std::size_t cache_line_size = 64;
+
+// Threads are given shards round robin, in the order they first touch any sharded unit,
+// so that as long as there are no more threads than shards no two of them share one.
+inline std::size_t thread_slot()
+{
+    static std::atomic<std::size_t> next{0};
+    thread_local const std::size_t slot = next.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+} // namespace detail
+
+template<typename _Unit>
+class sharded_atomic_unit
+{
+public:
+    using value_type = _Unit;
+    using rep        = typename _Unit::rep;
+
+    // one shard per hardware thread, rounded up to a power of two
+    sharded_atomic_unit()
+        : sharded_atomic_unit(std::thread::hardware_concurrency()) { }
+
+    explicit sharded_atomic_unit(std::size_t shards)
+        : _shards(new shard[round_up(shards)]), _mask(round_up(shards) - 1) { }
+
+    sharded_atomic_unit(const sharded_atomic_unit &) = delete;
+    sharded_atomic_unit &operator=(const sharded_atomic_unit &) = delete;
+
+    std::size_t shards() const noexcept { return _mask + 1; }
+
+    // adds `arg` to the shard of the calling thread, with relaxed ordering by default
+    // since nothing can be learnt from the value of a single shard anyway
+    template<typename _Rep2, typename _Ratio2,
+             class = std::enable_if_t<detail::converts_implicitly<_Rep2, rep>::value>>
+    void add(const unit<_Rep2, _Ratio2, typename _Unit::base> &arg,
+             std::memory_order order = std::memory_order_relaxed) noexcept
+    {
+        local().fetch_add(arg, order);
+    }
+
+    template<typename _Rep2, typename _Ratio2,
+             class = std::enable_if_t<detail::converts_implicitly<_Rep2, rep>::value>>
+    void subtract(const unit<_Rep2, _Ratio2, typename _Unit::base> &arg,
+                  std::memory_order order = std::memory_order_relaxed) noexcept
+    {
+        local().fetch_sub(arg, order);
+    }
+
+    template<typename _Rep2, typename _Ratio2,
+             class = std::enable_if_t<detail::converts_implicitly<_Rep2, rep>::value>>
+    sharded_atomic_unit &operator+=(const unit<_Rep2, _Ratio2, typename _Unit::base> &arg) noexcept
+    {
+        add(arg);
+        return *this;
+    }
+
+    template<typename _Rep2, typename _Ratio2,
+             class = std::enable_if_t<detail::converts_implicitly<_Rep2, rep>::value>>
+    sharded_atomic_unit &operator-=(const unit<_Rep2, _Ratio2, typename _Unit::base> &arg) noexcept
+    {
+        subtract(arg);
+        return *this;
+    }
+
+    // The sum of all shards. Every addition that happened before the call is included,
+    // additions concurrent with it may or may not be.
+    _Unit load(std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+        _Unit total{rep{0}};
+        for (std::size_t i = 0; i <= _mask; ++i) total += _shards[i].value.load(order);
+        return total;
+    }
+
+    // sets every shard to zero, additions concurrent with it may or may not be kept
+    void reset() noexcept
+    {
+        for (std::size_t i = 0; i <= _mask; ++i) _shards[i].value.store(_Unit{rep{0}});
+    }
+
+    operator _Unit() const noexcept { return load(); }
+
+private:
+    struct alignas(detail::cache_line_size) shard
+    {
+        atomic_unit<_Unit> value;
+    };
+
+    static std::size_t round_up(std::size_t shards)
+    {
+        std::size_t n = 1;
+        while (n < shards) n *= 2;
+        return n;
+    }
+
+    atomic_unit<_Unit> &local() noexcept { return _shards[detail::thread_slot() & _mask].value; }
+
+    std::unique_ptr<shard[]> _shards;
+    std::size_t _mask;
+};
+} // namespace si
@@ -0,0 +1,272 @@
+#pragma once
+
+#include "si/core.hpp"
+#include "si/numeric.hpp"
+#include "si/span.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <ratio>
+#include <type_traits>
+
+// Streaming integration and differentiation of sampled units over time.
+//
+// The integral of a unit over time has its base multiplied by seconds, and its
+// derivative its base divided by seconds, in the ratio of the unit: integrating
+// si::power<double, std::kilo> gives si::energy<double, std::kilo>, differentiating
+// si::length<double> gives si::velocity<double>. Both are computed in floating point
+// whatever the representation of the samples, and integrals are summed with
+// compensation, so that metering over long periods does not lose precision.
+//
+// si::integrator and si::differentiator take samples timestamped with any si::time,
+// and integrate with the trapezoid rule. si::uniform_integrator and
+// si::uniform_differentiator take samples at a fixed step, one by one or by chunks of
+// any size, and integrate with the trapezoid or Simpson's rule. Chunks are summed in
+// vectorised loops, and every operator keeps a constant amount of state across them.
+//
+//     si::uniform_integrator<si::power<float>, si::rule::simpson> meter{si::millisecond{10}};
+//     meter.push(chunk);
+//     si::energy<double> consumed = meter.total();
+namespace si
+{
+namespace detail
+{
+// the count of `t` in seconds
+template<typename _Real, typename _Rep, typename _Ratio>
+_Real seconds(const unit<_Rep, _Ratio, _s<1>> &t)
+{
+    return unit_cast<unit<_Real, std::ratio<1>, _s<1>>>(t).count();
+}
+} // namespace detail
+
+enum class rule { trapezoid, simpson };
+
+// The integral of samples at any times, which have to be pushed in order, with the
+// trapezoid rule
+template<typename _Unit, typename _Time = unit<double, std::ratio<1>, detail::_s<1>>>
+class integrator
+{
+    static_assert(detail::is_unit<_Unit>::value, "only units can be integrated");
+
+public:
+    using value_type    = _Unit;
+    using integral_type = integral_t<_Unit>;
+
+    void push(const _Time &t, const _Unit &value)
+    {
+        const auto v = static_cast<real>(value.count());
+        if (_started) {
+            assert(!(t < _last_time));
+            _total.add(real{0.5} * (_last + v) * detail::seconds<real>(t - _last_time));
+        }
+        _started = true;
+        _last_time = t;
+        _last = v;
+    }
+
+    integral_type total() const { return integral_type{_total.value()}; }
+
+    void reset() { *this = integrator{}; }
+
+private:
+    using real = detail::real_rep_t<_Unit>;
+
+    detail::compensated_sum<real> _total;
+    bool _started = false;
+    _Time _last_time;
+    real _last = 0;
+};
+
+// The integral of samples `step` apart, pushed one by one or by chunks. Simpson's rule
+// applies to pairs of intervals, an odd interval at the end of the samples so far is
+// integrated with the trapezoid rule until the next sample completes its pair.
+template<typename _Unit, rule _Rule = rule::trapezoid>
+class uniform_integrator
+{
+    static_assert(detail::is_unit<_Unit>::value, "only units can be integrated");
+
+public:
+    using value_type    = _Unit;
+    using integral_type = integral_t<_Unit>;
+
+    template<typename _Rep, typename _Ratio>
+    explicit uniform_integrator(const unit<_Rep, _Ratio, detail::_s<1>> &step)
+        : _step(detail::seconds<real>(step))
+    {
+        assert(_step > 0);
+    }
+
+    void push(const _Unit &value)
+    {
+        const auto v = static_cast<real>(value.count());
+        _weighted.add(weight(_count) * v);
+        advance(v);
+    }
+
+    // the samples of a contiguous range, such as an array, std::vector or si::span
+    template<typename _Range, class = detail::enable_if_unit_range_t<_Range>>
+    void push(const _Range &samples)
+    {
+        const auto in = detail::units_of(samples);
+        static_assert(std::is_same<typename decltype(in)::value_type, _Unit>::value, "the samples are not of the unit integrated");
+        const auto n = in.size();
+        if (n == 0) return;
+
+        const auto *data = in.data();
+        const auto offset = _count;
+        const auto chunk = detail::accumulate(0, n, detail::compensated_sum<real>{}, [data, offset](std::size_t i) {
+            return weight(offset + i) * static_cast<real>(data[i].count());
+        });
+        _weighted.merge(chunk);
+
+        if (_count == 0) _first = static_cast<real>(data[0].count());
+        _previous = n >= 2 ? static_cast<real>(data[n - 2].count()) : _last;
+        _last = static_cast<real>(data[n - 1].count());
+        _count += n;
+    }
+
+    integral_type total() const
+    {
+        if (_count < 2) return integral_type{0};
+        const real weighted = _weighted.value();
+        if constexpr (_Rule == rule::trapezoid) {
+            // every sample counts once, the first and the last half
+            return integral_type{_step * (weighted - real{0.5} * (_first + _last))};
+        } else if (_count % 2 == 1) {
+            // 1, 4, 2, 4, ..., 2, 4, 1 over 3
+            return integral_type{_step * (weighted - _first - _last) / 3};
+        } else {
+            // the same up to the sample before the last, which weighs 1, then a trapezoid
+            const real simpson = (weighted - 4 * _last - _first - _previous) / 3;
+            return integral_type{_step * (simpson + real{0.5} * (_previous + _last))};
+        }
+    }
+
+    void reset()
+    {
+        _weighted = {};
+        _count = 0;
+    }
+
+private:
+    using real = detail::real_rep_t<_Unit>;
+
+    // the weight of the i-th sample, before the corrections of total() for the ends
+    static real weight(std::size_t i)
+    {
+        if constexpr (_Rule == rule::trapezoid) {
+            return real{1};
+        } else {
+            return i % 2 == 0 ? real{2} : real{4};
+        }
+    }
+
+    void advance(real v)
+    {
+        if (_count == 0) _first = v;
+        _previous = _last;
+        _last = v;
+        ++_count;
+    }
+
+    real _step;
+    detail::compensated_sum<real> _weighted;
+    std::size_t _count = 0;
+    real _first = 0;
+    real _previous = 0;
+    real _last = 0;
+};
+
+// The rate of change of samples at any times, which have to be pushed in order
+template<typename _Unit, typename _Time = unit<double, std::ratio<1>, detail::_s<1>>>
+class differentiator
+{
+    static_assert(detail::is_unit<_Unit>::value, "only units can be differentiated");
+
+public:
+    using value_type      = _Unit;
+    using derivative_type = derivative_t<_Unit>;
+
+    // the rate of change since the previous sample, zero for the first one
+    derivative_type push(const _Time &t, const _Unit &value)
+    {
+        const auto v = static_cast<real>(value.count());
+        derivative_type rate{0};
+        if (_started) {
+            assert(_last_time < t);
+            rate = derivative_type{(v - _last) / detail::seconds<real>(t - _last_time)};
+        }
+        _started = true;
+        _last_time = t;
+        _last = v;
+        return rate;
+    }
+
+    void reset() { _started = false; }
+
+private:
+    using real = detail::real_rep_t<_Unit>;
+
+    bool _started = false;
+    _Time _last_time;
+    real _last = 0;
+};
+
+// The rate of change of samples `step` apart, by chunks: every sample but the very first
+// gives the rate since the previous one, which is the derivative at the middle of
+// their interval.
+template<typename _Unit>
+class uniform_differentiator
+{
+    static_assert(detail::is_unit<_Unit>::value, "only units can be differentiated");
+
+public:
+    using value_type      = _Unit;
+    using derivative_type = derivative_t<_Unit>;
+
+    template<typename _Rep, typename _Ratio>
+    explicit uniform_differentiator(const unit<_Rep, _Ratio, detail::_s<1>> &step)
+        : _rate(1 / detail::seconds<real>(step))
+    {
+        assert(_rate > 0);
+    }
+
+    // Writes the rates of the samples of `in` to `out`, which must be at least as large,
+    // and returns the part of `out` that was written to: one element less than `in` for
+    // the first chunk.
+    span<derivative_type> push(span<const _Unit> in, span<derivative_type> out)
+    {
+        assert(out.size() >= in.size());
+        const auto n = in.size();
+        if (n == 0) return out.first(0);
+
+        const auto *__restrict x = in.data();
+        const real rate = _rate;
+        const std::size_t written = _started ? n : n - 1;
+        if (_started) out[0] = derivative_type{(static_cast<real>(x[0].count()) - _last) * rate};
+
+        // the rate between samples i and i + 1 goes after the one of the first sample, if any
+        auto *__restrict y = out.data() + (_started ? 1 : 0);
+        for (std::size_t i = 0; i + 1 < n; ++i) {
+            y[i] = derivative_type{(static_cast<real>(x[i + 1].count()) - static_cast<real>(x[i].count())) * rate};
+        }
+        _started = true;
+        _last = static_cast<real>(x[n - 1].count());
+        return out.first(written);
+    }
+
+    span<derivative_type> push(span<_Unit> in, span<derivative_type> out)
+    {
+        return push(span<const _Unit>{in}, out);
+    }
+
+    void reset() { _started = false; }
+
+private:
+    using real = detail::real_rep_t<_Unit>;
+
+    real _rate;
+    bool _started = false;
+    real _last = 0;
+};
+} // namespace si
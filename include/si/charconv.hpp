@@ -0,0 +1,638 @@
+#pragma once
+
+#include "si/core.hpp"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+// Allocation free parsing and formatting of units, in the spirit of std::from_chars
+// and std::to_chars.
+//
+// When parsing, a number is followed by optional blanks and a SI symbol, with or without one of
+// the prefixes of si/units.hpp, for instance "12.5 km", "300 ms", "4.2e3 Pa" or
+// "7µA". The symbol is checked against the dimension of the requested unit and the
+// number is scaled to its ratio:
+//
+//     si::length<double, std::kilo> d;
+//     auto [ptr, ec] = si::from_chars(first, last, d);
+//
+// Symbols are found with a perfect hash computed at compile time, a lookup is a
+// multiplication, a shift and a single comparison.
+//
+// When formatting, the symbol is the product of the base units, mass first, with the
+// prefix matching the ratio of the unit, for instance "3.2 km", "15 ms" or
+// "2 kg·m·s⁻²". It is built at compile time, so writing a unit costs a std::to_chars
+// and a copy.
+namespace si
+{
+enum class parse_errc
+{
+    ok = 0,
+    invalid_number,     // there is no number at the start of the input
+    unknown_unit,       // the symbol is not a, possibly prefixed, SI symbol
+    dimension_mismatch, // the symbol is not of the dimension of the requested unit
+    out_of_range,       // the value cannot be represented in the requested unit
+};
+
+// ptr points past the symbol on success, to the number when it is invalid or out of
+// range, and to the symbol when it is unknown or of the wrong dimension
+struct from_chars_result
+{
+    const char *ptr;
+    parse_errc ec;
+};
+
+namespace detail
+{
+// exp10 is the power of ten of the symbol relative to the unit of the same dimension
+// in si, for which mass is in grams: a newton is a kg·m·s⁻², so 10³ g·m·s⁻²
+struct symbol
+{
+    std::string_view name;
+    dimension dim;
+    int exp10;
+};
+
+//                                     m   g   s   A  K mol cd
+inline constexpr symbol symbols[] = {
+    {"m",            {  1,  0,  0,  0, 0, 0, 0 },  0 },
+    {"g",            {  0,  1,  0,  0, 0, 0, 0 },  0 },
+    {"s",            {  0,  0,  1,  0, 0, 0, 0 },  0 },
+    {"A",            {  0,  0,  0,  1, 0, 0, 0 },  0 },
+    {"K",            {  0,  0,  0,  0, 1, 0, 0 },  0 },
+    {"mol",          {  0,  0,  0,  0, 0, 1, 0 },  0 },
+    {"cd",           {  0,  0,  0,  0, 0, 0, 1 },  0 },
+    {"rad",          {  0,  0,  0,  0, 0, 0, 0 },  0 },
+    {"sr",           {  0,  0,  0,  0, 0, 0, 0 },  0 },
+    {"Hz",           {  0,  0, -1,  0, 0, 0, 0 },  0 },
+    {"N",            {  1,  1, -2,  0, 0, 0, 0 },  3 },
+    {"Pa",           { -1,  1, -2,  0, 0, 0, 0 },  3 },
+    {"J",            {  2,  1, -2,  0, 0, 0, 0 },  3 },
+    {"W",            {  2,  1, -3,  0, 0, 0, 0 },  3 },
+    {"C",            {  0,  0,  1,  1, 0, 0, 0 },  0 },
+    {"V",            {  2,  1, -3, -1, 0, 0, 0 },  3 },
+    {"F",            { -2, -1,  4,  2, 0, 0, 0 }, -3 },
+    {"Ω",            {  2,  1, -3, -2, 0, 0, 0 },  3 },
+    {"ohm",          {  2,  1, -3, -2, 0, 0, 0 },  3 },
+    {"S",            { -2, -1,  3,  2, 0, 0, 0 }, -3 },
+    {"Wb",           {  2,  1, -2, -1, 0, 0, 0 },  3 },
+    {"T",            {  0,  1, -2, -1, 0, 0, 0 },  3 },
+    {"H",            {  2,  1, -2, -2, 0, 0, 0 },  3 },
+    {"lm",           {  0,  0,  0,  0, 0, 0, 1 },  0 },
+    {"lx",           { -2,  0,  0,  0, 0, 0, 1 },  0 },
+    {"Bq",           {  0,  0, -1,  0, 0, 0, 0 },  0 },
+    {"Gy",           {  2,  0, -2,  0, 0, 0, 0 },  0 },
+    {"Sv",           {  2,  0, -2,  0, 0, 0, 0 },  0 },
+    {"kat",          {  0,  0, -1,  0, 0, 1, 0 },  0 },
+};
+
+inline constexpr std::size_t symbol_count = sizeof(symbols) / sizeof(symbols[0]);
+
+// Symbols are looked up as the little endian word of their bytes, zero padded, which
+// the parser builds while scanning them. This makes the hash, the comparison and
+// stripping a prefix a couple of instructions each, without any loop over the bytes.
+using symbol_key = std::uint64_t;
+
+inline constexpr std::size_t max_symbol_size = sizeof(symbol_key);
+
+constexpr symbol_key make_symbol_key(std::string_view name)
+{
+    symbol_key key = 0;
+    for (std::size_t i = 0; i < name.size() && i < max_symbol_size; ++i) {
+        key |= symbol_key(static_cast<unsigned char>(name[i])) << (8 * i);
+    }
+    return key;
+}
+
+inline constexpr unsigned symbol_table_bits = 8;
+
+constexpr std::size_t symbol_hash(symbol_key key, symbol_key multiplier)
+{
+    return static_cast<std::size_t>((key * multiplier) >> (64 - symbol_table_bits));
+}
+
+// the first multiplier, in a pseudo random sequence, for which no two symbols hash to
+// the same slot
+constexpr symbol_key find_symbol_multiplier()
+{
+    symbol_key keys[symbol_count] = {};
+    for (std::size_t i = 0; i < symbol_count; ++i) keys[i] = make_symbol_key(symbols[i].name);
+
+    for (symbol_key multiplier = 0x9e3779b97f4a7c15u;;
+         multiplier = (multiplier * 6364136223846793005u + 1442695040888963407u) | 1) {
+        bool used[1 << symbol_table_bits] = {};
+        bool collision = false;
+        for (std::size_t i = 0; i < symbol_count && !collision; ++i) {
+            auto slot = symbol_hash(keys[i], multiplier);
+            collision = used[slot];
+            used[slot] = true;
+        }
+        if (!collision) return multiplier;
+    }
+}
+
+inline constexpr symbol_key symbol_multiplier = find_symbol_multiplier();
+
+struct symbol_slot
+{
+    symbol_key key;
+    std::int8_t index; // in symbols, -1 for none
+};
+
+inline constexpr auto symbol_table = [] {
+    std::array<symbol_slot, 1 << symbol_table_bits> table{};
+    for (auto &slot : table) slot = {0, -1};
+    for (std::size_t i = 0; i < symbol_count; ++i) {
+        const auto key = make_symbol_key(symbols[i].name);
+        table[symbol_hash(key, symbol_multiplier)] = {key, static_cast<std::int8_t>(i)};
+    }
+    return table;
+}();
+
+constexpr const symbol *find_symbol(symbol_key key)
+{
+    const auto &slot = symbol_table[symbol_hash(key, symbol_multiplier)];
+    return slot.key == key && slot.index >= 0 ? &symbols[slot.index] : nullptr;
+}
+
+// the power of ten of the prefix at the start of a key, and its length in bytes,
+// 0 for none
+struct prefix
+{
+    std::int8_t exp10;
+    std::uint8_t size;
+};
+
+// the single byte prefixes, the two byte ones are checked by find_prefix
+inline constexpr auto prefixes = [] {
+    std::array<prefix, 256> table{};
+    auto set = [&](char c, int exp10) {
+        table[static_cast<unsigned char>(c)] = {static_cast<std::int8_t>(exp10), 1};
+    };
+    set('a', -18); set('f', -15); set('p', -12); set('n', -9); set('u', -6);
+    set('m', -3);  set('c', -2);  set('d', -1);  set('h', 2);  set('k', 3);
+    set('M', 6);   set('G', 9);   set('T', 12);  set('P', 15); set('E', 18);
+    return table;
+}();
+
+constexpr prefix find_prefix(symbol_key key)
+{
+    switch (key & 0xffff) {
+    case 'd' | 'a' << 8: return {1, 2};   // deca
+    case 0xc2 | 0xb5 << 8: return {-6, 2}; // micro sign
+    case 0xce | 0xbc << 8: return {-6, 2}; // greek small letter mu
+    default: return prefixes[key & 0xff];
+    }
+}
+
+// the dimension and power of ten of a possibly prefixed symbol, a symbol taking
+// precedence over a prefixed one, so that "cd" is a candela and not a centi-something
+constexpr const symbol *find_unit(symbol_key key, int &exp10)
+{
+    if (const auto *s = find_symbol(key)) {
+        exp10 = s->exp10;
+        return s;
+    }
+    const auto p = find_prefix(key);
+    const auto rest = key >> (8 * p.size);
+    if (p.size == 0 || rest == 0) return nullptr;
+    const auto *s = find_symbol(rest);
+    if (s) exp10 = s->exp10 + p.exp10;
+    return s;
+}
+
+constexpr bool is_symbol_char(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || static_cast<unsigned char>(c) >= 0x80;
+}
+
+inline constexpr double pow10_table[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+// exact powers of ten up to 10²², which is more than every prefixed symbol needs
+inline double scale10(double value, int exp10)
+{
+    return exp10 >= 0 ? value * pow10_table[exp10] : value / pow10_table[-exp10];
+}
+
+// value * 10^exp10 / _Ratio, truncated like unit_cast when _Rep is integral
+template<typename _Rep, typename _Ratio>
+parse_errc scale_floating(double value, int exp10, _Rep &out)
+{
+    constexpr auto factor = static_cast<double>(_Ratio::den) / static_cast<double>(_Ratio::num);
+    const auto scaled = scale10(value, exp10) * factor;
+    if constexpr (is_integral_rep_v<_Rep>) {
+        constexpr auto max = static_cast<double>(std::numeric_limits<_Rep>::max()) + 1.0;
+        constexpr auto min = static_cast<double>(std::numeric_limits<_Rep>::lowest()) - 1.0;
+        if (!(scaled > min && scaled < max)) return parse_errc::out_of_range;
+    } else {
+        const auto rounded = static_cast<arithmetic_t<_Rep>>(static_cast<_Rep>(scaled));
+        if (std::isfinite(value) && !std::isfinite(rounded)) return parse_errc::out_of_range;
+    }
+    out = static_cast<_Rep>(scaled);
+    return parse_errc::ok;
+}
+
+// 10^exp10 / _Ratio as a reduced num / den, for every exp10 a prefixed symbol can
+// have, den is 0 when it does not fit
+inline constexpr int max_exp10 = 21;
+
+struct integral_factor
+{
+    long long num;
+    long long den;
+};
+
+template<typename _Ratio>
+inline constexpr auto integral_factors = [] {
+    std::array<integral_factor, 2 * max_exp10 + 1> factors{};
+    for (int e = -max_exp10; e <= max_exp10; ++e) {
+        long long num = _Ratio::den;
+        long long den = _Ratio::num;
+        bool fits = true;
+        for (int i = e; i > 0 && fits; --i) {
+            if (den % 10 == 0) den /= 10;
+            else fits = !__builtin_mul_overflow(num, 10, &num);
+        }
+        for (int i = e; i < 0 && fits; ++i) {
+            if (num % 10 == 0) num /= 10;
+            else fits = !__builtin_mul_overflow(den, 10, &den);
+        }
+        factors[e + max_exp10] = fits ? integral_factor{num, den} : integral_factor{0, 0};
+    }
+    return factors;
+}();
+
+// value * 10^exp10 / _Ratio exactly, truncated like unit_cast
+template<typename _Rep, typename _Ratio>
+parse_errc scale_integral(long long value, int exp10, _Rep &out)
+{
+    const auto &f = integral_factors<_Ratio>[exp10 + max_exp10];
+    if (f.den == 0) return parse_errc::out_of_range;
+
+    // in 64 bits, unless the representation is wider
+    using work = std::conditional_t<(sizeof(_Rep) > sizeof(long long)), wide_int, long long>;
+    const work num = f.num;
+    const work den = f.den;
+
+    // split on den first, like unit_cast, so that only a result out of range overflows
+    work result = 0;
+    const work q = value / den;
+    const work r = value % den;
+    work rn = 0;
+    if (__builtin_mul_overflow(q, num, &result) || __builtin_mul_overflow(r, num, &rn)
+            || __builtin_add_overflow(result, rn / den, &result)
+            || __builtin_add_overflow(result, 0, &out)) {
+        return parse_errc::out_of_range;
+    }
+    return parse_errc::ok;
+}
+
+constexpr bool is_floating_syntax(char c)
+{
+    return c == '.' || c == 'e' || c == 'E';
+}
+} // namespace detail
+
+template<typename _Rep, typename _Ratio, typename _Base>
+from_chars_result from_chars(const char *first, const char *last, unit<_Rep, _Ratio, _Base> &value)
+{
+    static_assert(std::is_arithmetic<_Rep>::value || detail::is_integral_rep_v<_Rep>
+                      || treat_as_floating_point_v<_Rep>,
+                  "from_chars needs an arithmetic representation");
+
+    // the number, parsed as an integer whenever possible so that integral units are exact
+    long long integer = 0;
+    double floating = 0;
+    bool is_integer = false;
+    const char *p = first;
+    if constexpr (detail::is_integral_rep_v<_Rep>) {
+        auto r = std::from_chars(first, last, integer);
+        if (r.ec == std::errc::result_out_of_range) return {first, parse_errc::out_of_range};
+        is_integer = r.ec == std::errc{} && (r.ptr == last || !detail::is_floating_syntax(*r.ptr));
+        p = r.ptr;
+    }
+    if (!is_integer) {
+        auto r = std::from_chars(first, last, floating);
+        if (r.ec == std::errc::result_out_of_range) return {first, parse_errc::out_of_range};
+        if (r.ec != std::errc{}) return {first, parse_errc::invalid_number};
+        p = r.ptr;
+    }
+
+    while (p != last && (*p == ' ' || *p == '\t')) ++p;
+    const char *symbol_first = p;
+    detail::symbol_key key = 0;
+    for (unsigned shift = 0; p != last && detail::is_symbol_char(*p); ++p, shift += 8) {
+        if (shift == 8 * detail::max_symbol_size) return {symbol_first, parse_errc::unknown_unit};
+        key |= detail::symbol_key(static_cast<unsigned char>(*p)) << shift;
+    }
+
+    // no symbol at all is a dimensionless number
+    constexpr detail::symbol dimensionless{{}, {}, 0};
+    int exp10 = 0;
+    const auto *symbol = key == 0 ? &dimensionless : detail::find_unit(key, exp10);
+    if (!symbol) return {symbol_first, parse_errc::unknown_unit};
+    if (!(symbol->dim == dimension_of<_Base>)) return {symbol_first, parse_errc::dimension_mismatch};
+
+    _Rep count{};
+    parse_errc ec;
+    if constexpr (detail::is_integral_rep_v<_Rep>) {
+        ec = is_integer ? detail::scale_integral<_Rep, _Ratio>(integer, exp10, count)
+                        : detail::scale_floating<_Rep, _Ratio>(floating, exp10, count);
+    } else {
+        ec = detail::scale_floating<_Rep, _Ratio>(floating, exp10, count);
+    }
+    if (ec != parse_errc::ok) return {first, ec};
+
+    value = unit<_Rep, _Ratio, _Base>{count};
+    return {p, parse_errc::ok};
+}
+
+// how to_chars chooses the prefix of the symbol
+enum class prefix_mode
+{
+    exact,     // the prefix of the ratio of the unit, the count is written unchanged
+               // unless no prefix matches the ratio
+    automatic, // the engineering prefix for which the written value is in [1, 1000)
+};
+
+namespace detail
+{
+// the text of a symbol, built at compile time
+struct symbol_text
+{
+    char data[64] = {};
+    std::size_t size = 0;
+
+    constexpr void append(std::string_view s)
+    {
+        for (char c : s) data[size++] = c;
+    }
+};
+
+constexpr void append_exponent(symbol_text &text, int exponent)
+{
+    constexpr std::string_view digits[] = {"⁰", "¹", "²", "³", "⁴", "⁵", "⁶", "⁷", "⁸", "⁹"};
+    if (exponent < 0) {
+        text.append("⁻");
+        exponent = -exponent;
+    }
+    int div = 1;
+    while (exponent / div >= 10) div *= 10;
+    for (; div > 0; div /= 10) text.append(digits[exponent / div % 10]);
+}
+
+// the product of the base units of _Base, without prefix, mass first so that the
+// prefix of kg·m·s⁻² applies to the gram
+template<typename _Base>
+inline constexpr auto coherent_symbol = [] {
+    const std::pair<std::string_view, int> factors[] = {
+        {"g", _Base::g}, {"m", _Base::m}, {"s", _Base::s}, {"A", _Base::A},
+        {"K", _Base::K}, {"mol", _Base::mol}, {"cd", _Base::cd},
+    };
+    symbol_text text;
+    for (const auto &[name, exponent] : factors) {
+        if (exponent == 0) continue;
+        if (text.size != 0) text.append("·");
+        text.append(name);
+        if (exponent != 1) append_exponent(text, exponent);
+    }
+    return text;
+}();
+
+// the exponent of the first factor of the symbol, the one the prefix applies to
+template<typename _Base>
+inline constexpr int leading_exponent = _Base::g   != 0 ? _Base::g
+                                      : _Base::m   != 0 ? _Base::m
+                                      : _Base::s   != 0 ? _Base::s
+                                      : _Base::A   != 0 ? _Base::A
+                                      : _Base::K   != 0 ? _Base::K
+                                      : _Base::mol != 0 ? _Base::mol
+                                      : _Base::cd;
+
+constexpr std::string_view prefix_symbol(int exp10)
+{
+    switch (exp10) {
+    case -18: return "a";
+    case -15: return "f";
+    case -12: return "p";
+    case  -9: return "n";
+    case  -6: return "µ";
+    case  -3: return "m";
+    case  -2: return "c";
+    case  -1: return "d";
+    case   0: return "";
+    case   1: return "da";
+    case   2: return "h";
+    case   3: return "k";
+    case   6: return "M";
+    case   9: return "G";
+    case  12: return "T";
+    case  15: return "P";
+    case  18: return "E";
+    default:  return {};
+    }
+}
+
+constexpr bool is_prefix(int exp10)
+{
+    return exp10 == 0 || !prefix_symbol(exp10).empty();
+}
+
+inline constexpr int no_prefix = std::numeric_limits<int>::min();
+
+// k for a _Ratio of 10^k, no_prefix for other ratios
+template<typename _Ratio>
+inline constexpr int ratio_exp10 = [] {
+    int exp10 = 0;
+    auto num = _Ratio::num, den = _Ratio::den;
+    for (; num % 10 == 0; num /= 10) ++exp10;
+    for (; den % 10 == 0; den /= 10) --exp10;
+    return num == 1 && den == 1 ? exp10 : no_prefix;
+}();
+
+// the power of ten of the prefix written for a unit of _Ratio, no_prefix if the ratio
+// is not one of a prefix applied to the first factor, as for std::ratio<1, 1000> m²
+template<typename _Ratio, typename _Base>
+inline constexpr int exact_prefix = [] {
+    constexpr int exp10 = ratio_exp10<_Ratio>;
+    constexpr int e = leading_exponent<_Base>;
+    if (exp10 == no_prefix) return no_prefix;
+    if (exp10 == 0) return 0;
+    if (e == 0 || exp10 % e != 0 || !is_prefix(exp10 / e)) return no_prefix;
+    return exp10 / e;
+}();
+
+// " " followed by the prefixed symbol, or nothing for dimensionless units
+template<typename _Base>
+constexpr symbol_text unit_symbol(int prefix)
+{
+    symbol_text text;
+    if (coherent_symbol<_Base>.size == 0) return text;
+    text.append(" ");
+    text.append(prefix_symbol(prefix));
+    text.append(std::string_view(coherent_symbol<_Base>.data, coherent_symbol<_Base>.size));
+    return text;
+}
+
+template<typename _Ratio, typename _Base>
+inline constexpr symbol_text exact_symbol = unit_symbol<_Base>(exact_prefix<_Ratio, _Base> == no_prefix
+                                                               ? 0 : exact_prefix<_Ratio, _Base>);
+
+// the symbols for every engineering prefix, from 10⁻¹⁸ to 10¹⁸
+inline constexpr int engineering_prefixes = 13;
+
+template<typename _Base>
+inline constexpr auto engineering_symbols = [] {
+    std::array<symbol_text, engineering_prefixes> symbols{};
+    for (int i = 0; i < engineering_prefixes; ++i) symbols[i] = unit_symbol<_Base>(3 * i - 18);
+    return symbols;
+}();
+
+constexpr double pow10(int exp10)
+{
+    double result = 1;
+    for (; exp10 > 0; --exp10) result *= 10;
+    for (; exp10 < 0; ++exp10) result /= 10;
+    return result;
+}
+
+// 10^(_E * p - _K) for every engineering prefix p, the smallest count of a unit of
+// ratio 10^_K written with it
+template<int _E, int _K>
+inline constexpr auto engineering_thresholds = [] {
+    std::array<double, engineering_prefixes> thresholds{};
+    for (int i = 0; i < engineering_prefixes; ++i) thresholds[i] = pow10(_E * (3 * i - 18) - _K);
+    return thresholds;
+}();
+
+// value / 10^exp10, exact for the powers of ten a double holds exactly
+template<typename _T>
+_T unscale10(_T value, int exp10)
+{
+    if (exp10 >= -22 && exp10 <= 22) return exp10 >= 0 ? value / pow10_table[exp10] : value * pow10_table[-exp10];
+    return value / static_cast<_T>(pow10(exp10));
+}
+
+inline std::to_chars_result write_symbol(char *first, char *last, const symbol_text &symbol)
+{
+    if (static_cast<std::size_t>(last - first) < symbol.size) return {last, std::errc::value_too_large};
+    for (std::size_t i = 0; i < symbol.size; ++i) first[i] = symbol.data[i];
+    return {first + symbol.size, std::errc{}};
+}
+
+template<typename _T>
+std::to_chars_result write_number(char *first, char *last, _T value)
+{
+    if constexpr (std::is_same<arithmetic_t<_T>, _T>::value) {
+        return std::to_chars(first, last, value);
+    } else {
+        // std::to_chars has no overload for half precision, and the float it widens to
+        // has far more digits than it holds: the fewest digits that round back to it
+        const auto widened = static_cast<float>(value);
+        if (!std::isfinite(widened)) return std::to_chars(first, last, widened);
+        double shortest = 0;
+        for (int precision = 1; precision <= std::numeric_limits<float>::max_digits10; ++precision) {
+            const auto r = std::to_chars(first, last, widened, std::chars_format::scientific, precision - 1);
+            if (r.ec != std::errc{}) return r;
+            std::from_chars(first, r.ptr, shortest);
+            if (static_cast<_T>(static_cast<float>(shortest)) == value) break;
+        }
+        return std::to_chars(first, last, shortest);
+    }
+}
+
+#if SI_HAS_INT128
+// std::to_chars only takes the 128 bit integers in the GNU dialects
+inline std::to_chars_result write_number(char *first, char *last, uint128_t magnitude, bool negative = false)
+{
+    char digits[40];
+    char *p = digits + sizeof(digits);
+    do {
+        *--p = static_cast<char>('0' + static_cast<int>(magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (negative) *--p = '-';
+
+    const auto size = static_cast<std::size_t>(digits + sizeof(digits) - p);
+    if (static_cast<std::size_t>(last - first) < size) return {last, std::errc::value_too_large};
+    for (std::size_t i = 0; i < size; ++i) first[i] = p[i];
+    return {first + size, std::errc{}};
+}
+
+inline std::to_chars_result write_number(char *first, char *last, int128_t value)
+{
+    const auto magnitude = static_cast<uint128_t>(value);
+    return write_number(first, last, value < 0 ? uint128_t{0} - magnitude : magnitude, value < 0);
+}
+#endif
+
+template<typename _T>
+std::to_chars_result write_value(char *first, char *last, _T value, const symbol_text &symbol)
+{
+    auto r = write_number(first, last, value);
+    if (r.ec != std::errc{}) return r;
+    return write_symbol(r.ptr, last, symbol);
+}
+} // namespace detail
+
+// Writes the unit, its value followed by a space and its symbol, to [first, last).
+// On success ptr points past the last character written, otherwise ec is
+// std::errc::value_too_large and ptr is last.
+template<typename _Rep, typename _Ratio, typename _Base>
+std::to_chars_result to_chars(char *first, char *last, const unit<_Rep, _Ratio, _Base> &value,
+                              prefix_mode mode = prefix_mode::exact)
+{
+    static_assert(std::is_arithmetic<_Rep>::value || detail::is_integral_rep_v<_Rep>
+                      || treat_as_floating_point_v<_Rep>,
+                  "to_chars needs an arithmetic representation");
+
+    using real = std::conditional_t<treat_as_floating_point_v<_Rep>, detail::arithmetic_t<_Rep>, double>;
+    constexpr auto prefix = detail::exact_prefix<_Ratio, _Base>;
+    constexpr auto ratio = static_cast<real>(_Ratio::num) / static_cast<real>(_Ratio::den);
+    constexpr auto e = detail::leading_exponent<_Base>;
+
+    if (mode == prefix_mode::exact || e == 0) {
+        if constexpr (prefix != detail::no_prefix) {
+            return detail::write_value(first, last, value.count(), detail::exact_symbol<_Ratio, _Base>);
+        } else {
+            const auto coherent = static_cast<real>(value.count()) * ratio;
+            return detail::write_value(first, last, coherent, detail::exact_symbol<_Ratio, _Base>);
+        }
+    }
+
+    // The largest prefix for which the written value is at least 1, the smallest for
+    // values too small for any of them. Units of ratio 10^k are scaled in one step,
+    // without going through their coherent value, so that 999 ns is not written as
+    // 999.0000000000001 ns.
+    constexpr auto k = detail::ratio_exp10<_Ratio> == detail::no_prefix ? 0 : detail::ratio_exp10<_Ratio>;
+    const auto count = detail::ratio_exp10<_Ratio> == detail::no_prefix
+        ? static_cast<real>(value.count()) * ratio
+        : static_cast<real>(value.count());
+    const auto magnitude = count < 0 ? -count : count;
+    const auto &thresholds = detail::engineering_thresholds<e, k>;
+    int i = e > 0 ? detail::engineering_prefixes - 1 : 0;
+    const int step = e > 0 ? -1 : 1;
+    for (; i != (e > 0 ? 0 : detail::engineering_prefixes - 1); i += step) {
+        if (magnitude >= thresholds[i]) break;
+    }
+    if (magnitude == 0 || !(magnitude <= std::numeric_limits<real>::max())) i = 6;
+
+    const auto exp10 = e * (3 * i - 18) - k;
+    if (detail::is_integral_rep_v<_Rep> && exp10 == 0) {
+        return detail::write_value(first, last, value.count(), detail::engineering_symbols<_Base>[i]);
+    }
+    const auto scaled = detail::unscale10(count, exp10);
+    return detail::write_value(first, last, scaled, detail::engineering_symbols<_Base>[i]);
+}
+} // namespace si
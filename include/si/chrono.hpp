@@ -0,0 +1,100 @@
+#pragma once
+
+#include "si/core.hpp"
+#include "si/span.hpp"
+
+#include <chrono>
+#include <type_traits>
+
+// Interoperability with std::chrono.
+//
+// si::time units convert implicitly to and from any std::chrono::duration, these
+// helpers convert explicitly and without changing the representation or the ratio.
+//
+// Arrays of durations are viewed as arrays of si::time of the same representation and
+// ratio, and back, without copying: both hold nothing but their count. Arrays of
+// another representation or ratio are converted with si::from_durations and
+// si::to_durations of si/convert.hpp.
+//
+//     std::vector<std::chrono::nanoseconds> deadlines = ...;
+//     si::span<si::time<std::int64_t, std::nano>> times = si::as_units(deadlines);
+namespace si
+{
+template<typename _Rep, typename _Ratio>
+constexpr std::chrono::duration<_Rep, _Ratio> to_duration(const unit<_Rep, _Ratio, detail::_s<1>> &t)
+{
+    return std::chrono::duration<_Rep, _Ratio>{t.count()};
+}
+
+template<typename _Rep, typename _Period>
+constexpr unit<_Rep, _Period, detail::_s<1>> from_duration(const std::chrono::duration<_Rep, _Period> &d)
+{
+    return unit<_Rep, _Period, detail::_s<1>>{d.count()};
+}
+
+namespace detail
+{
+// the si::time viewing a duration, and the duration viewing a si::time
+template<typename _T>
+struct time_view {};
+
+template<typename _Rep, typename _Period>
+struct time_view<std::chrono::duration<_Rep, _Period>>
+{
+    using type = unit<_Rep, _Period, _s<1>>;
+};
+
+template<typename _Rep, typename _Period>
+struct time_view<const std::chrono::duration<_Rep, _Period>>
+{
+    using type = const unit<_Rep, _Period, _s<1>>;
+};
+
+template<typename _T>
+struct duration_view {};
+
+template<typename _Rep, typename _Ratio>
+struct duration_view<unit<_Rep, _Ratio, _s<1>>>
+{
+    using type = std::chrono::duration<_Rep, _Ratio>;
+};
+
+template<typename _Rep, typename _Ratio>
+struct duration_view<const unit<_Rep, _Ratio, _s<1>>>
+{
+    using type = const std::chrono::duration<_Rep, _Ratio>;
+};
+
+// the element type of a contiguous container, const if the container is
+template<typename _Container>
+using element_t = std::remove_pointer_t<decltype(std::declval<_Container &>().data())>;
+} // namespace detail
+
+// The durations of a container such as std::vector or std::array, or of a si::span, as
+// si::time units of the same representation and ratio. Containers are taken by lvalue
+// reference, the span would not outlive a temporary one.
+template<typename _Container, typename _Time = typename detail::time_view<detail::element_t<_Container>>::type>
+span<_Time> as_units(_Container &durations) noexcept
+{
+    return detail::reinterpret_span<_Time>(span<detail::element_t<_Container>>{durations});
+}
+
+template<typename _T, typename _Time = typename detail::time_view<_T>::type>
+span<_Time> as_units(span<_T> durations) noexcept
+{
+    return detail::reinterpret_span<_Time>(durations);
+}
+
+// si::time units as durations of the same representation and ratio
+template<typename _Container, typename _Duration = typename detail::duration_view<detail::element_t<_Container>>::type>
+span<_Duration> as_durations(_Container &times) noexcept
+{
+    return detail::reinterpret_span<_Duration>(span<detail::element_t<_Container>>{times});
+}
+
+template<typename _T, typename _Duration = typename detail::duration_view<_T>::type>
+span<_Duration> as_durations(span<_T> times) noexcept
+{
+    return detail::reinterpret_span<_Duration>(times);
+}
+} // namespace si
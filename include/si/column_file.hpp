@@ -0,0 +1,439 @@
+#pragma once
+
+#include "si/core.hpp"
+#include "si/span.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// A binary, columnar file format for series of units, memory mapped when read so that
+// columns are used in place as spans of units, without parsing or copying.
+//
+// The file starts with a file_header, followed by the columns, each one the array of
+// the representations of its units aligned on 64 bytes, and ends with the directory:
+// a column_header per column with its name, dimension, ratio and representation.
+// Everything is in the byte order of the writer, a reader on a machine of another
+// byte order refuses the file rather than converting it.
+//
+//     si::column_writer w;
+//     w.open("samples.sicol");
+//     w.write("pressure", pressures);  // any range of a si::unit
+//     w.close();
+//
+//     si::column_file f;
+//     f.open("samples.sicol");
+//     si::span<const si::pressure<double>> p;
+//     if (f.column("pressure", p) == si::column_errc::ok) { ... }
+//
+// Reading relies on POSIX mmap.
+namespace si
+{
+enum class column_errc
+{
+    ok = 0,
+    io_error,           // the file could not be opened, written or mapped, see errno
+    invalid_format,     // not a column file, or one written on a machine of another byte order
+    invalid_name,       // the name is empty, too long, or already taken by another column
+    not_found,          // there is no column of that name
+    dimension_mismatch, // the column is not of the dimension of the requested unit
+    ratio_mismatch,     // the column is not of the ratio of the requested unit
+    rep_mismatch,       // the column does not hold the representation of the requested unit
+};
+
+// the representation of a column, the same on every platform
+enum class rep_type : std::uint8_t
+{
+    unknown = 0,
+    int8, int16, int32, int64, int128,
+    uint8, uint16, uint32, uint64, uint128,
+    float32, float64,
+    float16, bfloat16,
+};
+
+namespace detail
+{
+template<typename _Rep>
+constexpr rep_type rep_type_of()
+{
+    if constexpr (std::is_floating_point<_Rep>::value) {
+        if constexpr (sizeof(_Rep) == 4) return rep_type::float32;
+        else if constexpr (sizeof(_Rep) == 8) return rep_type::float64;
+        else return rep_type::unknown;
+    } else if constexpr (treat_as_floating_point_v<_Rep> && sizeof(_Rep) == 2) {
+        // told apart by their precision, so that si/half.hpp is not needed here
+        return std::numeric_limits<_Rep>::digits == 8 ? rep_type::bfloat16 : rep_type::float16;
+    } else if constexpr (is_integral_rep_v<_Rep> && !std::is_same<_Rep, bool>::value) {
+        constexpr rep_type types[2][5] = {
+            {rep_type::uint8, rep_type::uint16, rep_type::uint32, rep_type::uint64, rep_type::uint128},
+            {rep_type::int8, rep_type::int16, rep_type::int32, rep_type::int64, rep_type::int128},
+        };
+        constexpr int log2_size = sizeof(_Rep) == 1 ? 0 : sizeof(_Rep) == 2 ? 1 : sizeof(_Rep) == 4 ? 2
+                                : sizeof(_Rep) == 8 ? 3 : 4;
+        return types[std::numeric_limits<_Rep>::is_signed][log2_size];
+    } else {
+        return rep_type::unknown;
+    }
+}
+
+constexpr std::size_t rep_size(rep_type type)
+{
+    switch (type) {
+    case rep_type::int8: case rep_type::uint8: return 1;
+    case rep_type::int16: case rep_type::uint16: case rep_type::float16: case rep_type::bfloat16: return 2;
+    case rep_type::int32: case rep_type::uint32: case rep_type::float32: return 4;
+    case rep_type::int64: case rep_type::uint64: case rep_type::float64: return 8;
+    case rep_type::int128: case rep_type::uint128: return 16;
+    default: return 0;
+    }
+}
+
+inline constexpr char column_magic[8] = {'S', 'I', 'C', 'O', 'L', 'U', 'M', 'N'};
+inline constexpr std::uint32_t column_byte_order = 0x01020304;
+inline constexpr std::uint32_t column_version = 1;
+inline constexpr std::uint64_t column_alignment = 64;
+
+struct file_header
+{
+    char magic[8];
+    std::uint32_t byte_order;   // column_byte_order, as written by the writer
+    std::uint32_t version;
+    std::uint64_t directory_offset;
+    std::uint64_t column_count;
+};
+
+struct column_header
+{
+    char name[56];              // zero padded, only zero terminated when shorter
+    std::int8_t exponents[7];   // m, g, s, A, K, mol, cd, as in detail::base
+    rep_type rep;
+    std::int64_t ratio_num;
+    std::int64_t ratio_den;
+    std::uint64_t offset;       // of the first unit, from the start of the file
+    std::uint64_t count;
+};
+
+inline void store_exponents(dimension dim, std::int8_t (&exponents)[7])
+{
+    const int e[] = {dim.m(), dim.g(), dim.s(), dim.A(), dim.K(), dim.mol(), dim.cd()};
+    for (int i = 0; i < 7; ++i) exponents[i] = static_cast<std::int8_t>(e[i]);
+}
+
+static_assert(sizeof(file_header) == 32, "the file header is part of the format");
+static_assert(sizeof(column_header) == 96, "the column header is part of the format");
+static_assert(std::is_trivially_copyable<column_header>::value, "column headers are read in place");
+} // namespace detail
+
+// What a column holds, as read from the directory of a file
+class column_info
+{
+public:
+    explicit column_info(const detail::column_header &header)
+        : _header(&header) { }
+
+    std::string_view name() const
+    {
+        return {_header->name, strnlen(_header->name, sizeof(_header->name))};
+    }
+
+    si::dimension dim() const
+    {
+        const auto *e = _header->exponents;
+        return {e[0], e[1], e[2], e[3], e[4], e[5], e[6]};
+    }
+
+    std::int64_t ratio_num() const { return _header->ratio_num; }
+    std::int64_t ratio_den() const { return _header->ratio_den; }
+    rep_type rep() const { return _header->rep; }
+    std::size_t size() const { return static_cast<std::size_t>(_header->count); }
+
+    // whether the column holds units of type _Unit
+    template<typename _Unit>
+    column_errc matches() const
+    {
+        if (dim() != dimension_of<typename _Unit::base>) return column_errc::dimension_mismatch;
+        if (_header->ratio_num != _Unit::ratio::num || _header->ratio_den != _Unit::ratio::den) return column_errc::ratio_mismatch;
+        if (_header->rep != detail::rep_type_of<typename _Unit::rep>()) return column_errc::rep_mismatch;
+        return column_errc::ok;
+    }
+
+private:
+    const detail::column_header *_header;
+};
+
+// Writes the columns one after the other, each one streamed from a range of units,
+// and the directory when closed. The directory is the only thing kept in memory.
+class column_writer
+{
+public:
+    column_writer() = default;
+
+    column_writer(const column_writer &) = delete;
+    column_writer &operator=(const column_writer &) = delete;
+
+    column_writer(column_writer &&other) noexcept
+        : _file(std::exchange(other._file, nullptr)), _columns(std::move(other._columns)) { }
+
+    column_writer &operator=(column_writer &&other) noexcept
+    {
+        if (this != &other) {
+            close();
+            _file    = std::exchange(other._file, nullptr);
+            _columns = std::move(other._columns);
+        }
+        return *this;
+    }
+
+    // a writer destroyed without being closed still leaves a valid file
+    ~column_writer() { close(); }
+
+    column_errc open(const char *path)
+    {
+        close();
+        _file = std::fopen(path, "wb");
+        if (!_file) return column_errc::io_error;
+
+        const detail::file_header placeholder{};
+        if (std::fwrite(&placeholder, sizeof(placeholder), 1, _file) != 1) return column_errc::io_error;
+        return column_errc::ok;
+    }
+
+    bool is_open() const { return _file != nullptr; }
+
+    // Appends a column of the units of the range, which must hold a si::unit. Contiguous
+    // ranges are written in one go, others are streamed through a small buffer.
+    template<typename _Range>
+    column_errc write(std::string_view name, const _Range &units)
+    {
+        using unit_type = std::decay_t<decltype(*std::begin(units))>;
+        using rep = typename unit_type::rep;
+        using base = typename unit_type::base;
+        static_assert(detail::rep_type_of<rep>() != rep_type::unknown, "the representation cannot be stored");
+        static_assert(sizeof(unit_type) == sizeof(rep), "a unit must have the same size as its representation");
+        static_assert(dimension_of<base>.valid(), "the dimension cannot be stored");
+
+        if (!_file) return column_errc::io_error;
+        detail::column_header header{};
+        if (name.empty() || name.size() > sizeof(header.name)) return column_errc::invalid_name;
+        for (const auto &column : _columns) {
+            if (column_info{column}.name() == name) return column_errc::invalid_name;
+        }
+
+        std::memcpy(header.name, name.data(), name.size());
+        detail::store_exponents(dimension_of<base>, header.exponents);
+        header.rep       = detail::rep_type_of<rep>();
+        header.ratio_num = unit_type::ratio::num;
+        header.ratio_den = unit_type::ratio::den;
+        if (!align()) return column_errc::io_error;
+        header.offset = static_cast<std::uint64_t>(std::ftell(_file));
+
+        if constexpr (is_contiguous<_Range, unit_type>::value) {
+            header.count = static_cast<std::uint64_t>(std::size(units));
+            if (std::fwrite(std::data(units), sizeof(rep), std::size(units), _file) != std::size(units)) {
+                return column_errc::io_error;
+            }
+        } else {
+            rep buffer[512];
+            std::size_t n = 0;
+            for (const auto &u : units) {
+                buffer[n++] = u.count();
+                if (n == std::size(buffer)) {
+                    if (std::fwrite(buffer, sizeof(rep), n, _file) != n) return column_errc::io_error;
+                    header.count += n;
+                    n = 0;
+                }
+            }
+            if (std::fwrite(buffer, sizeof(rep), n, _file) != n) return column_errc::io_error;
+            header.count += n;
+        }
+
+        _columns.push_back(header);
+        return column_errc::ok;
+    }
+
+    // writes the directory, then the header pointing to it
+    column_errc close()
+    {
+        if (!_file) return column_errc::ok;
+
+        bool ok = align();
+        detail::file_header header{};
+        std::memcpy(header.magic, detail::column_magic, sizeof(header.magic));
+        header.byte_order       = detail::column_byte_order;
+        header.version          = detail::column_version;
+        header.directory_offset = static_cast<std::uint64_t>(std::ftell(_file));
+        header.column_count     = _columns.size();
+
+        ok = ok && std::fwrite(_columns.data(), sizeof(detail::column_header), _columns.size(), _file) == _columns.size();
+        ok = ok && std::fseek(_file, 0, SEEK_SET) == 0;
+        ok = ok && std::fwrite(&header, sizeof(header), 1, _file) == 1;
+        ok = std::fclose(_file) == 0 && ok;
+        _file = nullptr;
+        _columns.clear();
+        return ok ? column_errc::ok : column_errc::io_error;
+    }
+
+private:
+    template<typename _Range, typename _Unit, typename = void>
+    struct is_contiguous : std::false_type {};
+
+    template<typename _Range, typename _Unit>
+    struct is_contiguous<_Range, _Unit,
+                         std::void_t<decltype(std::data(std::declval<const _Range &>())),
+                                     decltype(std::size(std::declval<const _Range &>()))>>
+        : std::is_same<decltype(std::data(std::declval<const _Range &>())), const _Unit *> {};
+
+    // pads the file to the alignment of the next column
+    bool align()
+    {
+        static constexpr char zeros[detail::column_alignment] = {};
+        const auto position = std::ftell(_file);
+        if (position < 0) return false;
+        const auto padding = (detail::column_alignment - static_cast<std::uint64_t>(position) % detail::column_alignment)
+                           % detail::column_alignment;
+        return std::fwrite(zeros, 1, padding, _file) == padding;
+    }
+
+    std::FILE *_file = nullptr;
+    std::vector<detail::column_header> _columns;
+};
+
+// A column file mapped in memory. The spans it gives out point into the mapping, they
+// stay valid as long as the column_file is open.
+class column_file
+{
+public:
+    column_file() = default;
+
+    column_file(const column_file &) = delete;
+    column_file &operator=(const column_file &) = delete;
+
+    column_file(column_file &&other) noexcept
+        : _data(std::exchange(other._data, nullptr)), _size(std::exchange(other._size, 0)) { }
+
+    column_file &operator=(column_file &&other) noexcept
+    {
+        if (this != &other) {
+            close();
+            _data = std::exchange(other._data, nullptr);
+            _size = std::exchange(other._size, 0);
+        }
+        return *this;
+    }
+
+    ~column_file() { close(); }
+
+    column_errc open(const char *path)
+    {
+        close();
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return column_errc::io_error;
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            return column_errc::io_error;
+        }
+        const auto size = static_cast<std::size_t>(st.st_size);
+        if (size < sizeof(detail::file_header)) {
+            ::close(fd);
+            return column_errc::invalid_format;
+        }
+
+        void *data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) return column_errc::io_error;
+        _data = static_cast<const unsigned char *>(data);
+        _size = size;
+
+        if (!valid()) {
+            close();
+            return column_errc::invalid_format;
+        }
+        return column_errc::ok;
+    }
+
+    void close()
+    {
+        if (_data) ::munmap(const_cast<unsigned char *>(_data), _size);
+        _data = nullptr;
+        _size = 0;
+    }
+
+    bool is_open() const { return _data != nullptr; }
+
+    std::size_t columns() const { return is_open() ? static_cast<std::size_t>(header().column_count) : 0; }
+
+    column_info info(std::size_t i) const { return column_info{directory()[i]}; }
+
+    // the column of that name, as units of the type of the span
+    template<typename _Unit>
+    column_errc column(std::string_view name, span<const _Unit> &units) const
+    {
+        for (std::size_t i = 0; i < columns(); ++i) {
+            if (info(i).name() == name) return column(i, units);
+        }
+        return column_errc::not_found;
+    }
+
+    template<typename _Unit>
+    column_errc column(std::size_t i, span<const _Unit> &units) const
+    {
+        if (i >= columns()) return column_errc::not_found;
+        const auto ec = info(i).matches<_Unit>();
+        if (ec != column_errc::ok) return ec;
+
+        const auto &c = directory()[i];
+        units = {reinterpret_cast<const _Unit *>(_data + c.offset), static_cast<std::size_t>(c.count)};
+        return column_errc::ok;
+    }
+
+    // the raw bytes of the units of a column, for columns whose type is only known at
+    // runtime, see column_info
+    span<const unsigned char> bytes(std::size_t i) const
+    {
+        const auto &c = directory()[i];
+        return {_data + c.offset, static_cast<std::size_t>(c.count) * detail::rep_size(c.rep)};
+    }
+
+private:
+    const detail::file_header &header() const { return *reinterpret_cast<const detail::file_header *>(_data); }
+
+    const detail::column_header *directory() const
+    {
+        return reinterpret_cast<const detail::column_header *>(_data + header().directory_offset);
+    }
+
+    // everything the spans will point to is inside the file and aligned
+    bool valid() const
+    {
+        const auto &h = header();
+        if (std::memcmp(h.magic, detail::column_magic, sizeof(h.magic)) != 0) return false;
+        if (h.byte_order != detail::column_byte_order || h.version != detail::column_version) return false;
+        if (h.directory_offset % alignof(detail::column_header) != 0 || h.directory_offset > _size) return false;
+        if (h.column_count > (_size - h.directory_offset) / sizeof(detail::column_header)) return false;
+
+        for (std::size_t i = 0; i < h.column_count; ++i) {
+            const auto &c = directory()[i];
+            const auto size = detail::rep_size(c.rep);
+            if (size == 0 || c.offset % size != 0 || c.offset > _size) return false;
+            if (c.count > (_size - c.offset) / size) return false;
+        }
+        return true;
+    }
+
+    const unsigned char *_data = nullptr;
+    std::size_t _size = 0;
+};
+} // namespace si
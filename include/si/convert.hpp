@@ -0,0 +1,190 @@
+#pragma once
+
+#include "si/core.hpp"
+#include "si/span.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+// Runtime selection of the conversion kernels relies on the GCC/Clang target
+// attribute and cpu detection builtins, other compilers use the scalar kernel only.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SI_CONVERT_X86_DISPATCH 1
+#else
+#define SI_CONVERT_X86_DISPATCH 0
+#endif
+
+namespace si
+{
+namespace detail
+{
+// Every kernel runs the same unit_cast, so the batch conversion gives bit for bit
+// the results of the scalar one. The loop is blocked so that the inner loop has a
+// known trip count, which lets the compiler vectorize it even at -O2, and the blocks
+// end at a multiple of the block so that GCC sees the outer loop cannot wrap.
+#define SI_CONVERT_KERNEL_BODY                                          \
+    constexpr std::size_t block = 16;                                   \
+    std::size_t i = 0;                                                  \
+    const std::size_t blocks_end = n - n % block;                       \
+    for (; i < blocks_end; i += block) {                                \
+        for (std::size_t j = 0; j < block; ++j) {                       \
+            out[i + j] = unit_cast<_To>(in[i + j]);                     \
+        }                                                               \
+    }                                                                   \
+    for (; i < n; ++i) {                                                \
+        out[i] = unit_cast<_To>(in[i]);                                 \
+    }
+
+template<typename _To, typename _From>
+void convert_scalar(const _From *__restrict in, _To *__restrict out, std::size_t n)
+{
+    SI_CONVERT_KERNEL_BODY
+}
+
+#if SI_CONVERT_X86_DISPATCH
+template<typename _To, typename _From>
+__attribute__((target("sse2")))
+void convert_sse2(const _From *__restrict in, _To *__restrict out, std::size_t n)
+{
+    SI_CONVERT_KERNEL_BODY
+}
+
+template<typename _To, typename _From>
+__attribute__((target("avx2,f16c")))
+void convert_avx2(const _From *__restrict in, _To *__restrict out, std::size_t n)
+{
+    SI_CONVERT_KERNEL_BODY
+}
+
+// avx512dq is deliberately left out of this kernel, its 64 bit vpmullq is slower than
+// the shift and add sequences the compiler emits for constant factors without it.
+// f16c, which every avx2 cpu has, converts float16_t in vectors rather than with a
+// library call.
+template<typename _To, typename _From>
+__attribute__((target("avx512f,avx512bw,avx512vl,f16c,prefer-vector-width=512")))
+void convert_avx512(const _From *__restrict in, _To *__restrict out, std::size_t n)
+{
+    SI_CONVERT_KERNEL_BODY
+}
+
+// only for conversions between 64 bit integers and floating point, which avx512dq
+// does in one instruction and anything older one element at a time
+template<typename _To, typename _From>
+__attribute__((target("avx512f,avx512bw,avx512vl,avx512dq,f16c,prefer-vector-width=512")))
+void convert_avx512dq(const _From *__restrict in, _To *__restrict out, std::size_t n)
+{
+    SI_CONVERT_KERNEL_BODY
+}
+
+template<typename _To, typename _From>
+struct converts_int64_float
+    : std::integral_constant<bool,
+                             (std::is_integral<typename _From::rep>::value && sizeof(typename _From::rep) == 8
+                              && std::is_floating_point<typename _To::rep>::value)
+                                 || (std::is_floating_point<typename _From::rep>::value
+                                     && std::is_integral<typename _To::rep>::value
+                                     && sizeof(typename _To::rep) == 8)> {};
+
+enum class isa { scalar, sse2, avx2, avx512, avx512dq };
+
+inline isa detect_isa()
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")
+            && __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("f16c")) {
+        return __builtin_cpu_supports("avx512dq") ? isa::avx512dq : isa::avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c")) return isa::avx2;
+    if (__builtin_cpu_supports("sse2")) return isa::sse2;
+    return isa::scalar;
+}
+
+// the best instruction set available on this machine, detected once
+inline isa native_isa()
+{
+    static const isa detected = detect_isa();
+    return detected;
+}
+#endif
+
+#undef SI_CONVERT_KERNEL_BODY
+} // namespace detail
+
+// Converts every unit of `in` into the corresponding element of `out`, giving the
+// same result as calling unit_cast on each element. `out` must be at least as
+// large as `in`, the part of `out` that was written to is returned.
+template<typename _ToRep, typename _ToRatio, typename _Rep, typename _Ratio, typename _Base>
+span<unit<_ToRep, _ToRatio, _Base>> convert(span<const unit<_Rep, _Ratio, _Base>> in,
+                                            span<unit<_ToRep, _ToRatio, _Base>> out)
+{
+    using from = unit<_Rep, _Ratio, _Base>;
+    using to   = unit<_ToRep, _ToRatio, _Base>;
+
+    assert(out.size() >= in.size());
+    const auto n = in.size();
+
+#if SI_CONVERT_X86_DISPATCH
+    switch (detail::native_isa()) {
+    case detail::isa::avx512dq:
+        if constexpr (detail::converts_int64_float<to, from>::value) {
+            detail::convert_avx512dq<to, from>(in.data(), out.data(), n);
+            break;
+        }
+        [[fallthrough]];
+    case detail::isa::avx512: detail::convert_avx512<to, from>(in.data(), out.data(), n); break;
+    case detail::isa::avx2:   detail::convert_avx2<to, from>(in.data(), out.data(), n); break;
+    case detail::isa::sse2:   detail::convert_sse2<to, from>(in.data(), out.data(), n); break;
+    case detail::isa::scalar: detail::convert_scalar<to, from>(in.data(), out.data(), n); break;
+    }
+#else
+    detail::convert_scalar<to, from>(in.data(), out.data(), n);
+#endif
+    return out.first(n);
+}
+
+template<typename _ToRep, typename _ToRatio, typename _Rep, typename _Ratio, typename _Base>
+span<unit<_ToRep, _ToRatio, _Base>> convert(span<unit<_Rep, _Ratio, _Base>> in,
+                                            span<unit<_ToRep, _ToRatio, _Base>> out)
+{
+    return convert(span<const unit<_Rep, _Ratio, _Base>>{in}, out);
+}
+
+// Converts every std::chrono::duration of `in` into the corresponding si::time of
+// `out` as convert does. Durations are recognised by their shape, without <chrono>.
+template<typename _ToRep, typename _ToRatio, template<typename, typename> class _Duration, typename _Rep,
+         typename _Period, class = std::enable_if_t<detail::is_duration_v<_Duration<_Rep, _Period>, _Rep, _Period>>>
+span<unit<_ToRep, _ToRatio, detail::_s<1>>> from_durations(span<const _Duration<_Rep, _Period>> in,
+                                                           span<unit<_ToRep, _ToRatio, detail::_s<1>>> out)
+{
+    return convert(detail::reinterpret_span<const unit<_Rep, _Period, detail::_s<1>>>(in), out);
+}
+
+template<typename _ToRep, typename _ToRatio, template<typename, typename> class _Duration, typename _Rep,
+         typename _Period, class = std::enable_if_t<detail::is_duration_v<_Duration<_Rep, _Period>, _Rep, _Period>>>
+span<unit<_ToRep, _ToRatio, detail::_s<1>>> from_durations(span<_Duration<_Rep, _Period>> in,
+                                                           span<unit<_ToRep, _ToRatio, detail::_s<1>>> out)
+{
+    return from_durations(span<const _Duration<_Rep, _Period>>{in}, out);
+}
+
+// the reverse of from_durations
+template<template<typename, typename> class _Duration, typename _ToRep, typename _ToPeriod, typename _Rep,
+         typename _Ratio,
+         class = std::enable_if_t<detail::is_duration_v<_Duration<_ToRep, _ToPeriod>, _ToRep, _ToPeriod>>>
+span<_Duration<_ToRep, _ToPeriod>> to_durations(span<const unit<_Rep, _Ratio, detail::_s<1>>> in,
+                                                span<_Duration<_ToRep, _ToPeriod>> out)
+{
+    const auto units = detail::reinterpret_span<unit<_ToRep, _ToPeriod, detail::_s<1>>>(out);
+    return detail::reinterpret_span<_Duration<_ToRep, _ToPeriod>>(convert(in, units));
+}
+
+template<template<typename, typename> class _Duration, typename _ToRep, typename _ToPeriod, typename _Rep,
+         typename _Ratio,
+         class = std::enable_if_t<detail::is_duration_v<_Duration<_ToRep, _ToPeriod>, _ToRep, _ToPeriod>>>
+span<_Duration<_ToRep, _ToPeriod>> to_durations(span<unit<_Rep, _Ratio, detail::_s<1>>> in,
+                                                span<_Duration<_ToRep, _ToPeriod>> out)
+{
+    return to_durations(span<const unit<_Rep, _Ratio, detail::_s<1>>>{in}, out);
+}
+} // namespace si
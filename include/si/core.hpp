@@ -0,0 +1,822 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <ratio>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SIZEOF_INT128__)
+#define SI_HAS_INT128 1
+#else
+#define SI_HAS_INT128 0
+#endif
+
+#if defined(__FLT16_MAX__)
+#define SI_HAS_FLOAT16 1
+#else
+#define SI_HAS_FLOAT16 0
+#endif
+
+namespace si
+{
+template<typename _Rep, typename _Ratio, typename _Base>
+struct unit;
+
+#if SI_HAS_INT128
+// 128 bit representations, for exact integral counts beyond the range of int64_t
+__extension__ typedef __int128 int128_t;
+__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+#if SI_HAS_FLOAT16
+// the IEEE 754 half precision type, where the compiler provides one
+typedef _Float16 float16_t;
+#endif
+
+// Whether a representation is a floating point number, to which any other one converts
+// implicitly since nothing is truncated. Specialise it for other floating point types,
+// as for std::chrono::treat_as_floating_point, see si/half.hpp.
+template<typename _Rep>
+struct treat_as_floating_point : std::is_floating_point<_Rep> {};
+
+#if SI_HAS_FLOAT16
+template<> struct treat_as_floating_point<float16_t> : std::true_type {};
+#endif
+
+template<typename _Rep>
+inline constexpr bool treat_as_floating_point_v = treat_as_floating_point<_Rep>::value;
+
+// The exponents of m, g, s, A, K, mol and cd, 4 bits each from the least significant
+// bits, in two's complement so that each one is in [-8, 7]. An exponent out of that
+// range makes the dimension invalid: like a NaN, an invalid dimension propagates
+// through multiplications and divisions and never compares equal to a valid one.
+class dimension
+{
+public:
+    static constexpr int min_exponent = -8;
+    static constexpr int max_exponent = 7;
+
+    // dimensionless
+    constexpr dimension() = default;
+
+    constexpr dimension(int m, int g, int s, int A, int K, int mol, int cd)
+    {
+        const int exponents[] = {m, g, s, A, K, mol, cd};
+        for (int i = 0; i < 7; ++i) {
+            if (exponents[i] < min_exponent || exponents[i] > max_exponent) _bits |= invalid_bit;
+            _bits |= (static_cast<std::uint32_t>(exponents[i]) & 0xf) << (4 * i);
+        }
+    }
+
+    static constexpr dimension invalid() { return dimension{invalid_bit}; }
+
+    constexpr int m() const { return exponent(0); }
+    constexpr int g() const { return exponent(1); }
+    constexpr int s() const { return exponent(2); }
+    constexpr int A() const { return exponent(3); }
+    constexpr int K() const { return exponent(4); }
+    constexpr int mol() const { return exponent(5); }
+    constexpr int cd() const { return exponent(6); }
+
+    constexpr bool valid() const { return (_bits & invalid_bit) == 0; }
+
+    // the packed exponents, for hashing or storing
+    constexpr std::uint32_t bits() const { return _bits; }
+
+    friend constexpr bool operator==(dimension lhs, dimension rhs)
+    {
+        return lhs._bits == rhs._bits && lhs.valid();
+    }
+
+    friend constexpr bool operator!=(dimension lhs, dimension rhs) { return !(lhs == rhs); }
+
+    // Every exponent is added with its top bit masked out, so that no carry crosses
+    // into the next one, then the top bits are put back with a xor. An exponent
+    // overflows when both operands have the same sign and the result has the other.
+    friend constexpr dimension operator*(dimension lhs, dimension rhs)
+    {
+        const auto a = lhs._bits;
+        const auto b = rhs._bits;
+        const auto sum = (((a & low_bits) + (b & low_bits)) ^ ((a ^ b) & sign_bits)) & exponent_bits;
+        const auto overflow = ~(a ^ b) & (a ^ sum) & sign_bits;
+        return dimension{sum | ((a | b) & invalid_bit) | (overflow ? invalid_bit : 0)};
+    }
+
+    friend constexpr dimension operator/(dimension lhs, dimension rhs)
+    {
+        const auto a = lhs._bits;
+        const auto b = rhs._bits;
+        const auto difference = (((a | sign_bits) - (b & low_bits)) ^ ((a ^ ~b) & sign_bits)) & exponent_bits;
+        const auto overflow = (a ^ b) & (a ^ difference) & sign_bits;
+        return dimension{difference | ((a | b) & invalid_bit) | (overflow ? invalid_bit : 0)};
+    }
+
+private:
+    static constexpr std::uint32_t exponent_bits = 0x0fffffff;
+    static constexpr std::uint32_t sign_bits     = 0x08888888;
+    static constexpr std::uint32_t low_bits      = exponent_bits & ~sign_bits;
+    static constexpr std::uint32_t invalid_bit   = 0x10000000;
+
+    explicit constexpr dimension(std::uint32_t bits)
+        : _bits(bits) { }
+
+    constexpr int exponent(int i) const
+    {
+        const auto e = static_cast<int>((_bits >> (4 * i)) & 0xf);
+        return e > max_exponent ? e - 16 : e;
+    }
+
+    std::uint32_t _bits = 0;
+};
+
+// the dimension of a base, see detail::base
+template<typename _Base>
+inline constexpr dimension dimension_of{_Base::m, _Base::g, _Base::s, _Base::A, _Base::K, _Base::mol, _Base::cd};
+} // namespace si
+
+namespace std
+{
+// The largest ratio both are integral multiples of, in lowest terms whatever the ratios
+// it is given, so that units with equal ratios written differently, std::ratio<2, 42>
+// and std::ratio<1, 21>, have a single common type and their products a single unit.
+template <intmax_t _Num1, intmax_t _Den1,
+          intmax_t _Num2, intmax_t _Den2>
+struct common_type<std::ratio<_Num1, _Den1>, std::ratio<_Num2, _Den2>> {
+private:
+    using ratio1 = std::ratio<_Num1, _Den1>;
+    using ratio2 = std::ratio<_Num2, _Den2>;
+    static constexpr auto gcd_num = std::gcd(ratio1::num, ratio2::num);
+    static constexpr auto gcd_den = std::gcd(ratio1::den, ratio2::den);
+
+public:
+    using type = std::ratio<gcd_num, (ratio1::den / gcd_den) * ratio2::den>;
+};
+
+template <typename _Rep1, typename _Ratio1, typename _Base1,
+          typename _Rep2, typename _Ratio2, typename _Base2>
+struct common_type<si::unit<_Rep1, _Ratio1, _Base1>,
+                   si::unit<_Rep2, _Ratio2, _Base2>> {
+private:
+    using common_rep   = std::common_type_t<_Rep1, _Rep2>;
+    using common_ratio = std::common_type_t<_Ratio1, _Ratio2>;
+    using common_base  = typename std::enable_if_t<std::is_same<_Base1, _Base2>::value, _Base1>;
+public:
+    using type = si::unit<common_rep, common_ratio, common_base>;
+};
+} // namespace std
+
+namespace si
+{
+namespace detail
+{
+template <int _m = 0, int _g = 0, int _s = 0, int _A = 0, int _K = 0, int _mol = 0, int _cd = 0>
+struct base {
+    constexpr static int m   = _m;
+    constexpr static int g   = _g;
+    constexpr static int s   = _s;
+    constexpr static int A   = _A;
+    constexpr static int K   = _K;
+    constexpr static int mol = _mol;
+    constexpr static int cd  = _cd;
+};
+
+// base units                         m  g  s  A  K mol cd
+template<int p = 1> using _m   = base<p, 0, 0, 0, 0, 0, 0>;
+template<int p = 1> using _g   = base<0, p, 0, 0, 0, 0, 0>;
+template<int p = 1> using _s   = base<0, 0, p, 0, 0, 0, 0>;
+template<int p = 1> using _A   = base<0, 0, 0, p, 0, 0, 0>;
+template<int p = 1> using _K   = base<0, 0, 0, 0, p, 0, 0>;
+template<int p = 1> using _mol = base<0, 0, 0, 0, 0, p, 0>;
+template<int p = 1> using _cd  = base<0, 0, 0, 0, 0, 0, p>;
+
+// radian and steradian are dimensionless, unfortunately that means that they cannot be
+// differentiated with the current implementation.
+template<int p = 1> using _rad = base<>;
+template<int p = 1> using _sr  = base<>;
+
+template <typename Lhs, typename Rhs>
+using base_multiply = base<Lhs::m + Rhs::m,
+                           Lhs::g + Rhs::g,
+                           Lhs::s + Rhs::s,
+                           Lhs::A + Rhs::A,
+                           Lhs::K + Rhs::K,
+                           Lhs::mol + Rhs::mol,
+                           Lhs::cd + Rhs::cd>;
+
+template <typename Lhs, typename Rhs>
+using base_divide = base<Lhs::m - Rhs::m,
+                         Lhs::g - Rhs::g,
+                         Lhs::s - Rhs::s,
+                         Lhs::A - Rhs::A,
+                         Lhs::K - Rhs::K,
+                         Lhs::mol - Rhs::mol,
+                         Lhs::cd - Rhs::cd>;
+
+template <typename Lhs>
+using base_inverse = base<-Lhs::m,
+                          -Lhs::g,
+                          -Lhs::s,
+                          -Lhs::A,
+                          -Lhs::K,
+                          -Lhs::mol,
+                          -Lhs::cd>;
+
+// why is this not in the stdandard?
+template <typename T, typename U>
+struct implication
+    : std::disjunction<std::negation<T>, U>
+{};
+
+template <typename T, typename U>
+inline constexpr bool implication_v = implication<T, U>::value;
+
+// std::chrono::duration, recognised by its shape so that <chrono> is only needed by
+// the code actually converting to it, see si/chrono.hpp
+template <typename T, typename _Rep, typename _Period, typename = void>
+struct is_duration : std::false_type {};
+
+template <typename T, typename _Rep, typename _Period>
+struct is_duration<T, _Rep, _Period,
+                   std::void_t<typename T::rep, typename T::period, decltype(std::declval<T>().count())>>
+    : std::conjunction<std::is_same<typename T::rep, _Rep>, std::is_same<typename T::period, _Period>>
+{};
+
+template <typename T, typename _Rep, typename _Period>
+inline constexpr bool is_duration_v = is_duration<T, _Rep, _Period>::value;
+
+// the widest integer available, for the intermediate results of integral conversions
+#if SI_HAS_INT128
+using wide_int = int128_t;
+#else
+using wide_int = std::intmax_t;
+#endif
+
+// std::is_integral only knows about the 128 bit integers in the GNU dialects
+template <typename T>
+struct is_integral_rep : std::is_integral<T> {};
+
+#if SI_HAS_INT128
+template <> struct is_integral_rep<int128_t> : std::true_type {};
+template <> struct is_integral_rep<uint128_t> : std::true_type {};
+#endif
+
+template <typename T>
+inline constexpr bool is_integral_rep_v = is_integral_rep<T>::value;
+
+// Half precision is a storage format, arithmetic on it is done in float, which is
+// what the hardware does anyway
+template <typename _Rep>
+using arithmetic_t = std::conditional_t<treat_as_floating_point_v<_Rep> && (sizeof(_Rep) < sizeof(float)),
+                                        float, _Rep>;
+
+// statistics and integrals are computed in floating point whatever the representation
+template <typename _Unit>
+using real_rep_t = std::conditional_t<treat_as_floating_point_v<typename _Unit::rep>,
+                                      arithmetic_t<typename _Unit::rep>, double>;
+
+template <typename _Unit>
+using real_unit_t = unit<real_rep_t<_Unit>, typename _Unit::ratio, typename _Unit::base>;
+
+// std::numeric_limits, which the standard library only specialises for float16_t
+// from C++23 on
+template <typename _Rep>
+struct limits : std::numeric_limits<_Rep> {};
+
+#if SI_HAS_FLOAT16
+template <>
+struct limits<float16_t>
+{
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = true;
+    static constexpr float16_t max() { return static_cast<float16_t>(65504.0f); }
+    static constexpr float16_t lowest() { return static_cast<float16_t>(-65504.0f); }
+};
+#endif
+
+template <typename T>
+struct is_unit : std::false_type {};
+
+template <typename _Rep, typename _Ratio, typename _Base>
+struct is_unit<unit<_Rep, _Ratio, _Base>> : std::true_type {};
+
+// Representations that scale themselves, such as si::fixed: unit_cast hands them the
+// ratio of the conversion instead of scaling their value, see si/fixed.hpp
+template <typename T>
+struct is_fixed : std::false_type {};
+
+template <typename T>
+inline constexpr bool is_fixed_v = is_fixed<T>::value;
+
+template <typename _ToRep, typename _Ratio, typename _Rep>
+constexpr _ToRep convert_fixed(const _Rep &count);
+
+// Representations holding several counts at once, such as std::experimental::simd:
+// unit_cast scales every lane, see si/simd.hpp
+template <typename T>
+struct is_pack : std::false_type {};
+
+template <typename T>
+inline constexpr bool is_pack_v = is_pack<T>::value;
+
+template <typename _ToRep, typename _CommonRep, typename _Ratio, typename _Rep>
+_ToRep convert_pack(const _Rep &count);
+
+// Whether units convert implicitly from _From to _To, which they do unless a fraction
+// would be truncated: floating point converts only to floating point, fixed point only
+// to fixed or floating point
+template <typename _From, typename _To>
+struct converts_implicitly
+    : std::conjunction<implication<treat_as_floating_point<_From>, treat_as_floating_point<_To>>,
+                       implication<is_fixed<_From>, std::disjunction<is_fixed<_To>, treat_as_floating_point<_To>>>>
+{};
+
+// whether a count of _Ratio is a whole count of _ToRatio
+template <typename _Ratio, typename _ToRatio>
+struct divides_exactly : std::bool_constant<std::ratio_divide<_Ratio, _ToRatio>::den == 1> {};
+
+// whether the duration T converts to the time of _ToRep and _ToRatio without truncating,
+// as std::chrono has it: to floating point, or to a ratio it is a multiple of
+template <typename T, typename _Rep, typename _Ratio, typename _ToRep, typename _ToRatio>
+struct duration_converts_implicitly
+    : std::conjunction<is_duration<T, _Rep, _Ratio>, converts_implicitly<_Rep, _ToRep>,
+                       std::disjunction<treat_as_floating_point<_ToRep>, divides_exactly<_Ratio, _ToRatio>>>
+{};
+
+// whether the positive value v fits in _Int
+template <typename _Int>
+constexpr bool fits(wide_int v)
+{
+    _Int out = 0;
+    return !__builtin_add_overflow(v, 0, &out);
+}
+
+constexpr wide_int multiply_or_max(wide_int a, wide_int b)
+{
+    wide_int out = 0;
+    return __builtin_mul_overflow(a, b, &out) ? std::numeric_limits<wide_int>::max() : out;
+}
+
+// _Int, or when _V does not fit in it, the smallest integer holding both _V and every
+// value of _Int
+template <typename _Int, wide_int _V>
+using holding_t = std::conditional_t<fits<_Int>(_V), _Int,
+                  std::conditional_t<(sizeof(_Int) < sizeof(std::intmax_t)) && fits<std::intmax_t>(_V),
+                                     std::intmax_t, wide_int>>;
+
+// Scales a count by _Ratio, doing the arithmetic in _CommonRep. The path is picked at
+// compile time so that only the work the ratio actually requires ends up in the code.
+// Integers are only widened where a factor of the ratio does not fit in _CommonRep, so
+// that the intermediate results never overflow unless the result itself does.
+template <typename _ToRep, typename _CommonRep, typename _Ratio, typename _Rep>
+constexpr _ToRep convert_count(const _Rep &count)
+{
+    constexpr auto num = _Ratio::num;
+    constexpr auto den = _Ratio::den;
+
+    if constexpr (is_fixed_v<_ToRep> || is_fixed_v<_Rep>) {
+        return convert_fixed<_ToRep, _Ratio>(count);
+    } else if constexpr (is_pack_v<_ToRep> || is_pack_v<_Rep>) {
+        return convert_pack<_ToRep, _CommonRep, _Ratio>(count);
+    } else if constexpr (num == 1 && den == 1) {
+        return static_cast<_ToRep>(count);
+    } else if constexpr (treat_as_floating_point_v<_CommonRep>) {
+        // fold the ratio into a single factor, a multiply is much cheaper than a divide
+        using real = arithmetic_t<_CommonRep>;
+        constexpr auto factor = static_cast<real>(num) / static_cast<real>(den);
+        return static_cast<_ToRep>(static_cast<real>(count) * factor);
+    } else if constexpr (den == 1) {
+        using work = holding_t<_CommonRep, num>;
+        return static_cast<_ToRep>(static_cast<work>(count) * static_cast<work>(num));
+    } else if constexpr (num == 1) {
+        using work = holding_t<_CommonRep, den>;
+        return static_cast<_ToRep>(static_cast<work>(count) / static_cast<work>(den));
+    } else {
+        // split the count on den first, so that multiplying by num cannot overflow
+        // unless the result itself does, the remainder times num gets the width it needs
+        using work      = holding_t<_CommonRep, (num > den ? num : den)>;
+        using remainder = holding_t<work, multiply_or_max(den - 1, num)>;
+        const auto c = static_cast<work>(count);
+        const auto q = c / static_cast<work>(den);
+        const auto r = static_cast<remainder>(c % static_cast<work>(den));
+        return static_cast<_ToRep>(q * static_cast<work>(num)
+                + static_cast<work>(r * static_cast<remainder>(num) / static_cast<remainder>(den)));
+    }
+}
+
+template <typename _Rep>
+constexpr bool is_negative(const _Rep &value)
+{
+    if constexpr (std::numeric_limits<_Rep>::is_signed) {
+        return value < 0;
+    } else {
+        return false;
+    }
+}
+
+// whether every value of the integer _Rep is a std::intmax_t, which rules out the 64 bit
+// unsigned and the 128 bit integers
+template <typename _Rep>
+inline constexpr bool fits_intmax = sizeof(_Rep) < sizeof(std::intmax_t)
+                                 || (sizeof(_Rep) == sizeof(std::intmax_t) && std::numeric_limits<_Rep>::is_signed);
+
+// Scales a count by _Ratio into _ToRep, clamped to the range of _ToRep. overflow is set
+// when the value had to be clamped, a NaN converted to an integer becomes 0.
+template <typename _ToRep, typename _Ratio, typename _Rep>
+constexpr _ToRep saturate_count(const _Rep &count, bool &overflow)
+{
+    using limits = detail::limits<_ToRep>;
+    constexpr wide_int num = _Ratio::num;
+    constexpr wide_int den = _Ratio::den;
+
+    if constexpr (is_integral_rep_v<_Rep> && is_integral_rep_v<_ToRep>) {
+        // exact, in 64 bits whenever both representations fit in them
+        constexpr bool narrow = fits_intmax<_Rep> && fits_intmax<_ToRep>;
+        using work      = std::conditional_t<narrow, std::intmax_t, wide_int>;
+        using remainder = holding_t<work, multiply_or_max(den - 1, num)>;
+
+        work c = 0;
+        work result = 0;
+        work rn = 0;
+        overflow = __builtin_add_overflow(count, 0, &c);
+        if (!overflow) {
+            const work q = c / static_cast<work>(den);
+            const auto r = static_cast<remainder>(c % static_cast<work>(den));
+            rn = static_cast<work>(r * static_cast<remainder>(num) / static_cast<remainder>(den));
+            overflow = __builtin_mul_overflow(q, static_cast<work>(num), &result)
+                    || __builtin_add_overflow(result, rn, &result);
+        }
+
+        _ToRep out = 0;
+        if (!overflow && !__builtin_add_overflow(result, 0, &out)) return out;
+        overflow = true;
+        return is_negative(count) != (num < 0) ? limits::lowest() : limits::max();
+    } else if constexpr (treat_as_floating_point_v<_ToRep>) {
+        using common_rep = std::common_type_t<_Rep, _ToRep>;
+        const auto result = convert_count<_ToRep, common_rep, _Ratio>(count);
+        // an infinity that was not already one
+        if ((result > limits::max() || result < limits::lowest()) && count - count == 0) {
+            overflow = true;
+            return result > 0 ? limits::max() : limits::lowest();
+        }
+        return result;
+    } else {
+        using real = std::common_type_t<_Rep, double>;
+        const auto value = convert_count<real, real, _Ratio>(count);
+        // the bounds are powers of two, exact in floating point, anything above the
+        // lowest minus one truncates into range. Where the lowest minus one rounds back
+        // to the lowest, as for 64 bits in double, no value lies between them.
+        constexpr auto max_plus_one = static_cast<real>(limits::max() / 2 + 1) * 2;
+        constexpr auto lowest       = static_cast<real>(limits::lowest());
+        constexpr bool exact_below  = lowest - 1 < lowest;
+        overflow = true;
+        if (value != value) return 0;
+        if (!(value < max_plus_one)) return limits::max();
+        if (!(exact_below ? value > lowest - 1 : value >= lowest)) return limits::lowest();
+        overflow = false;
+        return static_cast<_ToRep>(value);
+    }
+}
+} // namespace detail
+
+// the integral of _Unit over time, in floating point and in the ratio of _Unit, so
+// kilowatts integrate to kilojoules
+template<typename _Unit>
+using integral_t = unit<detail::real_rep_t<_Unit>, typename _Unit::ratio,
+                        detail::base_multiply<typename _Unit::base, detail::_s<1>>>;
+
+// the derivative of _Unit with respect to time, likewise
+template<typename _Unit>
+using derivative_t = unit<detail::real_rep_t<_Unit>, typename _Unit::ratio,
+                          detail::base_divide<typename _Unit::base, detail::_s<1>>>;
+
+template<typename _ToUnit, typename _Rep, typename _Ratio, typename _Base>
+constexpr auto unit_cast(const unit<_Rep, _Ratio, _Base> &other)
+    -> std::enable_if_t<std::is_same<typename _ToUnit::base, _Base>::value, _ToUnit>
+{
+    using to_ratio   = typename _ToUnit::ratio;
+    using to_rep     = typename _ToUnit::rep;
+    using ratio_tf   = std::ratio_divide<_Ratio, to_ratio>;
+    using common_rep = typename std::common_type_t<_Rep, to_rep>;
+
+    return _ToUnit{detail::convert_count<to_rep, common_rep, ratio_tf>(other.count())};
+}
+
+// What unit_cast does when the value does not fit in the representation of the result:
+// saturate clamps it to the closest representable value, checked also reports whether
+// it had to. Both are exact for integers whatever the ratio, the default unit_cast is
+// too as long as the result fits, but leaves an overflow undetected.
+struct saturate_t { explicit saturate_t() = default; };
+struct checked_t { explicit checked_t() = default; };
+
+inline constexpr saturate_t saturate{};
+inline constexpr checked_t checked{};
+
+template<typename _Unit>
+struct checked_result
+{
+    _Unit value;   // saturated when overflow is set
+    bool overflow;
+};
+
+template<typename _ToUnit, typename _Rep, typename _Ratio, typename _Base>
+constexpr auto unit_cast(const unit<_Rep, _Ratio, _Base> &other, saturate_t)
+    -> std::enable_if_t<std::is_same<typename _ToUnit::base, _Base>::value, _ToUnit>
+{
+    using ratio_tf = std::ratio_divide<_Ratio, typename _ToUnit::ratio>;
+
+    bool overflow = false;
+    return _ToUnit{detail::saturate_count<typename _ToUnit::rep, ratio_tf>(other.count(), overflow)};
+}
+
+template<typename _ToUnit, typename _Rep, typename _Ratio, typename _Base>
+constexpr auto unit_cast(const unit<_Rep, _Ratio, _Base> &other, checked_t)
+    -> std::enable_if_t<std::is_same<typename _ToUnit::base, _Base>::value, checked_result<_ToUnit>>
+{
+    using ratio_tf = std::ratio_divide<_Ratio, typename _ToUnit::ratio>;
+
+    bool overflow = false;
+    const auto count = detail::saturate_count<typename _ToUnit::rep, ratio_tf>(other.count(), overflow);
+    return {_ToUnit{count}, overflow};
+}
+
+template<typename _Rep, typename _Ratio, typename _Base>
+struct unit
+{
+    using rep   = _Rep;
+    using ratio = _Ratio;
+    using base  = _Base;
+
+    constexpr unit() = default;
+    explicit constexpr unit(rep count)
+        : _count(count) { }
+
+    template<typename _Rep2, typename _Ratio2, typename _Base2,
+             class = std::enable_if_t<detail::converts_implicitly<_Rep2, rep>::value>>
+    constexpr unit(const unit<_Rep2, _Ratio2, _Base2> &other)
+        : _count(unit_cast<unit>(other).count()) { }
+
+    constexpr rep count() const { return _count; }
+
+    // the right hand side is converted once to this unit, the result stays in this unit
+    template<typename _Rep2, typename _Ratio2,
+             class = std::enable_if_t<detail::converts_implicitly<_Rep2, rep>::value>>
+    constexpr unit &operator+=(const unit<_Rep2, _Ratio2, base> &other)
+    {
+        _count += unit_cast<unit>(other).count();
+        return *this;
+    }
+
+    template<typename _Rep2, typename _Ratio2,
+             class = std::enable_if_t<detail::converts_implicitly<_Rep2, rep>::value>>
+    constexpr unit &operator-=(const unit<_Rep2, _Ratio2, base> &other)
+    {
+        _count -= unit_cast<unit>(other).count();
+        return *this;
+    }
+
+    constexpr unit &operator*=(const rep &factor)
+    {
+        _count *= factor;
+        return *this;
+    }
+
+    constexpr unit &operator/=(const rep &divisor)
+    {
+        _count /= divisor;
+        return *this;
+    }
+
+    constexpr unit &operator++() { ++_count; return *this; }
+    constexpr unit operator++(int) { return unit{_count++}; }
+    constexpr unit &operator--() { --_count; return *this; }
+    constexpr unit operator--(int) { return unit{_count--}; }
+
+private:
+    rep _count = 0;
+};
+
+// partial specialisation for "time"
+// this allows us to add conversion operators to std::chrono, without including it
+template<typename _Rep, typename _Ratio>
+struct unit<_Rep, _Ratio, detail::_s<1>>
+{
+    using rep   = _Rep;
+    using ratio = _Ratio;
+    using base  = detail::_s<1>;
+
+    constexpr unit() = default;
+    explicit constexpr unit(rep count)
+        : _count(count) { }
+
+    template<typename _Rep2, typename _Ratio2, typename _Base2>
+    constexpr unit(const unit<_Rep2, _Ratio2, _Base2> &other)
+        : _count(unit_cast<unit>(other).count()) { }
+
+    // from any std::chrono::duration, converted as from the si::time of the same
+    // representation and ratio. Like std::chrono, only when nothing is truncated: lossy
+    // durations go through from_duration and unit_cast.
+    template<template<typename, typename> class _Duration, typename _Rep2, typename _Ratio2,
+             class = std::enable_if_t<detail::duration_converts_implicitly<_Duration<_Rep2, _Ratio2>, _Rep2,
+                                                                           _Ratio2, rep, ratio>::value>>
+    constexpr unit(const _Duration<_Rep2, _Ratio2> &d)
+        : _count(unit_cast<unit>(unit<_Rep2, _Ratio2, base>{d.count()}).count()) { }
+
+    constexpr rep count() const { return _count; }
+
+    template<typename _Rep2, typename _Ratio2,
+             class = std::enable_if_t<detail::converts_implicitly<_Rep2, rep>::value>>
+    constexpr unit &operator+=(const unit<_Rep2, _Ratio2, base> &other)
+    {
+        _count += unit_cast<unit>(other).count();
+        return *this;
+    }
+
+    template<typename _Rep2, typename _Ratio2,
+             class = std::enable_if_t<detail::converts_implicitly<_Rep2, rep>::value>>
+    constexpr unit &operator-=(const unit<_Rep2, _Ratio2, base> &other)
+    {
+        _count -= unit_cast<unit>(other).count();
+        return *this;
+    }
+
+    constexpr unit &operator*=(const rep &factor)
+    {
+        _count *= factor;
+        return *this;
+    }
+
+    constexpr unit &operator/=(const rep &divisor)
+    {
+        _count /= divisor;
+        return *this;
+    }
+
+    constexpr unit &operator++() { ++_count; return *this; }
+    constexpr unit operator++(int) { return unit{_count++}; }
+    constexpr unit &operator--() { --_count; return *this; }
+    constexpr unit operator--(int) { return unit{_count--}; }
+
+    template<template<typename, typename> class _Duration, typename _Rep2, typename _Ratio2,
+             class = std::enable_if_t<detail::is_duration_v<_Duration<_Rep2, _Ratio2>, _Rep2, _Ratio2>>>
+    constexpr operator _Duration<_Rep2, _Ratio2>() const {
+        using common_rep   = std::common_type_t<rep, _Rep2>;
+        using common_ratio = std::common_type_t<ratio, _Ratio2>;
+        using common_unit = unit<common_rep, common_ratio, base>;
+        return _Duration<common_rep, common_ratio>{ common_unit(*this).count() };
+    }
+
+private:
+    rep _count = 0;
+};
+
+template <typename _Rep1, typename _Ratio1, typename _Base1,
+          typename _Rep2, typename _Ratio2, typename _Base2,
+          class = std::enable_if_t<std::is_same<_Base1, _Base2>::value>>
+constexpr auto operator==(const unit<_Rep1, _Ratio1, _Base1> &lhs,
+                          const unit<_Rep2, _Ratio2, _Base2> &rhs)
+{
+    using u1 = unit<_Rep1, _Ratio1, _Base1>;
+    using u2 = unit<_Rep2, _Ratio2, _Base2>;
+    using common_unit = typename std::common_type_t<u1, u2>;
+
+    return common_unit{lhs}.count() == common_unit{rhs}.count();
+}
+
+template <typename _Rep1, typename _Ratio1, typename _Base1,
+          typename _Rep2, typename _Ratio2, typename _Base2,
+          class = std::enable_if_t<std::is_same<_Base1, _Base2>::value>>
+constexpr auto operator<(const unit<_Rep1, _Ratio1, _Base1> &lhs,
+                         const unit<_Rep2, _Ratio2, _Base2> &rhs)
+{
+    using u1 = unit<_Rep1, _Ratio1, _Base1>;
+    using u2 = unit<_Rep2, _Ratio2, _Base2>;
+    using common_unit = typename std::common_type_t<u1, u2>;
+
+    return common_unit{lhs}.count() < common_unit{rhs}.count();
+}
+
+template <typename _Rep1, typename _Ratio1, typename _Base1,
+          typename _Rep2, typename _Ratio2, typename _Base2,
+          class = std::enable_if_t<std::is_same<_Base1, _Base2>::value>>
+constexpr auto operator!=(const unit<_Rep1, _Ratio1, _Base1> &lhs,
+                          const unit<_Rep2, _Ratio2, _Base2> &rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename _Rep1, typename _Ratio1, typename _Base1,
+          typename _Rep2, typename _Ratio2, typename _Base2,
+          class = std::enable_if_t<std::is_same<_Base1, _Base2>::value>>
+constexpr auto operator<=(const unit<_Rep1, _Ratio1, _Base1> &lhs,
+                          const unit<_Rep2, _Ratio2, _Base2> &rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <typename _Rep1, typename _Ratio1, typename _Base1,
+          typename _Rep2, typename _Ratio2, typename _Base2,
+          class = std::enable_if_t<std::is_same<_Base1, _Base2>::value>>
+constexpr auto operator>(const unit<_Rep1, _Ratio1, _Base1> &lhs,
+                         const unit<_Rep2, _Ratio2, _Base2> &rhs)
+{
+    return rhs < lhs;
+}
+
+template <typename _Rep1, typename _Ratio1, typename _Base1,
+          typename _Rep2, typename _Ratio2, typename _Base2,
+          class = std::enable_if_t<std::is_same<_Base1, _Base2>::value>>
+constexpr auto operator>=(const unit<_Rep1, _Ratio1, _Base1> &lhs,
+                          const unit<_Rep2, _Ratio2, _Base2> &rhs)
+{
+    return !(lhs < rhs);
+}
+
+template <typename _Rep1, typename _Ratio1, typename _Base1,
+          typename _Rep2, typename _Ratio2, typename _Base2,
+          class = std::enable_if_t<std::is_same<_Base1, _Base2>::value>>
+constexpr auto operator+(const unit<_Rep1, _Ratio1, _Base1> &lhs,
+                         const unit<_Rep2, _Ratio2, _Base2> &rhs)
+{
+    using u1 = unit<_Rep1, _Ratio1, _Base1>;
+    using u2 = unit<_Rep2, _Ratio2, _Base2>;
+    using common_unit = typename std::common_type_t<u1, u2>;
+
+    return common_unit{common_unit{lhs}.count() + common_unit{rhs}.count()};
+}
+
+template <typename _Rep1, typename _Ratio1, typename _Base1,
+          typename _Rep2, typename _Ratio2, typename _Base2,
+          class = std::enable_if_t<std::is_same<_Base1, _Base2>::value>>
+constexpr auto operator-(const unit<_Rep1, _Ratio1, _Base1> &lhs,
+                         const unit<_Rep2, _Ratio2, _Base2> &rhs)
+{
+    using u1 = unit<_Rep1, _Ratio1, _Base1>;
+    using u2 = unit<_Rep2, _Ratio2, _Base2>;
+    using common_unit = typename std::common_type_t<u1, u2>;
+
+    return common_unit{common_unit{lhs}.count() - common_unit{rhs}.count()};
+}
+
+template <typename _Rep1, typename _Ratio1, typename _Base1,
+          typename _Rep2, typename _Ratio2, typename _Base2>
+constexpr auto operator*(const unit<_Rep1, _Ratio1, _Base1> &lhs,
+                         const unit<_Rep2, _Ratio2, _Base2> &rhs)
+{
+    using common_base = detail::base_multiply<_Base1, _Base2>;
+    using common_ratio = typename std::common_type_t<_Ratio1, _Ratio2>;
+    using common_rep = typename std::common_type_t<_Rep1, _Rep2>;
+
+    return unit<common_rep, common_ratio, common_base>{lhs.count() * rhs.count()};
+}
+
+template <typename _Rep1, typename _Ratio1, typename _Base1,
+          typename _Rep2, class = std::common_type_t<_Rep1, _Rep2>>
+constexpr auto operator*(const unit<_Rep1, _Ratio1, _Base1> &lhs,
+                         const _Rep2 &rhs)
+{
+    using common_unit = unit<std::common_type_t<_Rep1, _Rep2>, _Ratio1, _Base1>;
+    return common_unit{common_unit{lhs}.count() * rhs};
+}
+
+template <typename _Rep1, typename _Ratio1, typename _Base1,
+          typename _Rep2, class = std::common_type_t<_Rep1, _Rep2>>
+constexpr auto operator*(const _Rep2 &lhs,
+                         const unit<_Rep1, _Ratio1, _Base1> &rhs)
+{
+    return rhs * lhs;
+}
+
+template <typename _Rep1, typename _Ratio1, typename _Base1,
+          typename _Rep2, typename _Ratio2, typename _Base2>
+constexpr auto operator/(const unit<_Rep1, _Ratio1, _Base1> &lhs,
+                         const unit<_Rep2, _Ratio2, _Base2> &rhs)
+{
+    using common_base = detail::base_divide<_Base1, _Base2>;
+    using common_ratio = typename std::common_type_t<_Ratio1, _Ratio2>;
+    using common_rep = typename std::common_type_t<_Rep1, _Rep2>;
+
+    return unit<common_rep, common_ratio, common_base>{lhs.count() / rhs.count()};
+}
+
+template <typename _Rep1, typename _Ratio1, typename _Base1,
+          typename _Rep2, class = std::common_type_t<_Rep1, _Rep2>>
+constexpr auto operator/(const unit<_Rep1, _Ratio1, _Base1> &lhs,
+                         const _Rep2 &rhs)
+{
+    using common_rep = std::common_type_t<_Rep1, _Rep2>;
+    using common_unit = unit<common_rep, _Ratio1, _Base1>;
+    return common_unit{common_unit{lhs}.count() / rhs};
+}
+
+template <typename _Rep1, typename _Ratio1, typename _Base1,
+          typename _Rep2, class = std::common_type_t<_Rep1, _Rep2>>
+constexpr auto operator/(const _Rep2 &lhs,
+                         const unit<_Rep1, _Ratio1, _Base1> &rhs)
+{
+    using common_rep = std::common_type_t<_Rep1, _Rep2>;
+    using common_unit = unit<common_rep, _Ratio1, detail::base_inverse<_Base1>>;
+    return common_unit{lhs / rhs.count()};
+}
+} // namespace si
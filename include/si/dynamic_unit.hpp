@@ -0,0 +1,146 @@
+#pragma once
+
+#include "si/core.hpp"
+
+#include <limits>
+#include <ratio>
+
+// Units whose dimension is only known at runtime, for instance read from a
+// configuration file or the header of a column.
+//
+// The seven exponents of a si::dimension are packed into a single 32 bit word, so that
+// checking that two dimensions are the same is one integer compare, and multiplying
+// or dividing them is a carry free add or subtract of the packed exponents. The ratio
+// is kept as a scale factor to the coherent unit, mass in grams like the static units.
+//
+//     si::dynamic_unit d = si::length<int, std::kilo>{3};   // 3 km
+//     si::length<double, std::milli> mm;
+//     if (si::unit_cast(d, mm) == si::dynamic_errc::ok) { ... }
+namespace si
+{
+enum class dynamic_errc
+{
+    ok = 0,
+    dimension_mismatch, // the dynamic unit is not of the dimension of the static one
+    out_of_range,       // the value cannot be represented in the static unit
+};
+
+// A double count of a unit of runtime dimension and scale. The value in the coherent
+// unit is count() * scale().
+//
+// Adding, subtracting or comparing units of different dimensions gives an invalid
+// dimension and a NaN count, or false, rather than failing: the result is checked
+// once, when it is converted back to a static unit.
+class dynamic_unit
+{
+public:
+    constexpr dynamic_unit() = default;
+
+    constexpr dynamic_unit(double count, double scale, dimension dim)
+        : _count(count), _scale(scale), _dim(dim) { }
+
+    template<typename _Rep, typename _Ratio, typename _Base>
+    constexpr dynamic_unit(const unit<_Rep, _Ratio, _Base> &other)
+        : _count(static_cast<double>(other.count()))
+        , _scale(static_cast<double>(_Ratio::num) / static_cast<double>(_Ratio::den))
+        , _dim(dimension_of<_Base>) { }
+
+    constexpr double count() const { return _count; }
+    constexpr double scale() const { return _scale; }
+    constexpr dimension dim() const { return _dim; }
+
+    // the value in the coherent unit of the dimension
+    constexpr double coherent() const { return _count * _scale; }
+
+    // the right hand side is converted to the scale of the left hand side
+    friend constexpr dynamic_unit operator+(const dynamic_unit &lhs, const dynamic_unit &rhs)
+    {
+        if (lhs._dim != rhs._dim) return mismatch(lhs);
+        return {lhs._count + rhs._count * (rhs._scale / lhs._scale), lhs._scale, lhs._dim};
+    }
+
+    friend constexpr dynamic_unit operator-(const dynamic_unit &lhs, const dynamic_unit &rhs)
+    {
+        if (lhs._dim != rhs._dim) return mismatch(lhs);
+        return {lhs._count - rhs._count * (rhs._scale / lhs._scale), lhs._scale, lhs._dim};
+    }
+
+    friend constexpr dynamic_unit operator*(const dynamic_unit &lhs, const dynamic_unit &rhs)
+    {
+        return {lhs._count * rhs._count, lhs._scale * rhs._scale, lhs._dim * rhs._dim};
+    }
+
+    friend constexpr dynamic_unit operator/(const dynamic_unit &lhs, const dynamic_unit &rhs)
+    {
+        return {lhs._count / rhs._count, lhs._scale / rhs._scale, lhs._dim / rhs._dim};
+    }
+
+    friend constexpr dynamic_unit operator*(const dynamic_unit &lhs, double rhs)
+    {
+        return {lhs._count * rhs, lhs._scale, lhs._dim};
+    }
+
+    friend constexpr dynamic_unit operator*(double lhs, const dynamic_unit &rhs) { return rhs * lhs; }
+
+    friend constexpr dynamic_unit operator/(const dynamic_unit &lhs, double rhs)
+    {
+        return {lhs._count / rhs, lhs._scale, lhs._dim};
+    }
+
+    friend constexpr dynamic_unit operator/(double lhs, const dynamic_unit &rhs)
+    {
+        return {lhs / rhs._count, 1 / rhs._scale, dimension{} / rhs._dim};
+    }
+
+    friend constexpr bool operator==(const dynamic_unit &lhs, const dynamic_unit &rhs)
+    {
+        return lhs._dim == rhs._dim && lhs.coherent() == rhs.coherent();
+    }
+
+    friend constexpr bool operator!=(const dynamic_unit &lhs, const dynamic_unit &rhs) { return !(lhs == rhs); }
+
+    friend constexpr bool operator<(const dynamic_unit &lhs, const dynamic_unit &rhs)
+    {
+        return lhs._dim == rhs._dim && lhs.coherent() < rhs.coherent();
+    }
+
+    friend constexpr bool operator>(const dynamic_unit &lhs, const dynamic_unit &rhs) { return rhs < lhs; }
+
+    friend constexpr bool operator<=(const dynamic_unit &lhs, const dynamic_unit &rhs)
+    {
+        return lhs._dim == rhs._dim && lhs.coherent() <= rhs.coherent();
+    }
+
+    friend constexpr bool operator>=(const dynamic_unit &lhs, const dynamic_unit &rhs) { return rhs <= lhs; }
+
+private:
+    static constexpr dynamic_unit mismatch(const dynamic_unit &lhs)
+    {
+        return {std::numeric_limits<double>::quiet_NaN(), lhs._scale, dimension::invalid()};
+    }
+
+    double _count = 0;
+    double _scale = 1;
+    dimension _dim;
+};
+
+// Converts to the static unit of to, which is only written when the dimensions match
+// and the value fits in its representation.
+template<typename _Rep, typename _Ratio, typename _Base>
+constexpr dynamic_errc unit_cast(const dynamic_unit &from, unit<_Rep, _Ratio, _Base> &to)
+{
+    if (from.dim() != dimension_of<_Base>) return dynamic_errc::dimension_mismatch;
+
+    // the count as is when the scales are the same, so that it round trips exactly
+    constexpr auto num = static_cast<double>(_Ratio::num);
+    constexpr auto den = static_cast<double>(_Ratio::den);
+    const auto value = from.scale() == num / den ? from.count() : from.coherent() * den / num;
+
+    bool overflow = false;
+    const auto count = detail::saturate_count<_Rep, std::ratio<1>>(value, overflow);
+    if (overflow) return dynamic_errc::out_of_range;
+
+    to = unit<_Rep, _Ratio, _Base>{count};
+    return dynamic_errc::ok;
+}
+} // namespace si
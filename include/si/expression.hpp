@@ -0,0 +1,265 @@
+#pragma once
+
+#include "si/core.hpp"
+#include "si/span.hpp"
+#include "si/unit_vector.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+// Lazy element-wise arithmetic over arrays of units.
+//
+// Adding, subtracting, multiplying or dividing unit_vectors, spans of units or
+// expressions builds an expression instead of computing anything. The whole
+// expression is then evaluated in a single loop by si::evaluate or si::assign,
+// without any temporary array:
+//
+//     si::unit_vector<si::energy<double>> e = si::evaluate(force * distance + other_energy);
+//
+// The type of the result, and whether the operation is allowed at all, is decided
+// by the scalar operators on si::unit, so dimensions and ratios are checked at
+// compile time exactly as they would be on single units.
+namespace si
+{
+template<typename _Node>
+class expression;
+
+namespace detail
+{
+struct plus {
+    template<typename L, typename R>
+    constexpr auto operator()(const L &lhs, const R &rhs) const -> decltype(lhs + rhs)
+    {
+        return lhs + rhs;
+    }
+};
+
+struct minus {
+    template<typename L, typename R>
+    constexpr auto operator()(const L &lhs, const R &rhs) const -> decltype(lhs - rhs)
+    {
+        return lhs - rhs;
+    }
+};
+
+struct multiplies {
+    template<typename L, typename R>
+    constexpr auto operator()(const L &lhs, const R &rhs) const -> decltype(lhs * rhs)
+    {
+        return lhs * rhs;
+    }
+};
+
+struct divides {
+    template<typename L, typename R>
+    constexpr auto operator()(const L &lhs, const R &rhs) const -> decltype(lhs / rhs)
+    {
+        return lhs / rhs;
+    }
+};
+
+// an array of units taking part in an expression, it is only referenced
+template<typename _Unit>
+struct array_node {
+    using value_type = _Unit;
+    static constexpr bool is_array = true;
+
+    const _Unit *data;
+    std::size_t count;
+
+    constexpr std::size_t size() const { return count; }
+    constexpr const _Unit &operator[](std::size_t i) const { return data[i]; }
+};
+
+// a single unit or number, applied to every element
+template<typename _T>
+struct scalar_node {
+    using value_type = _T;
+    static constexpr bool is_array = false;
+
+    _T value;
+
+    constexpr std::size_t size() const { return std::numeric_limits<std::size_t>::max(); }
+    constexpr const _T &operator[](std::size_t) const { return value; }
+};
+
+template<typename _Op, typename _Lhs, typename _Rhs>
+struct binary_node {
+    using value_type = decltype(_Op{}(std::declval<typename _Lhs::value_type>(),
+                                      std::declval<typename _Rhs::value_type>()));
+    static constexpr bool is_array = true;
+
+    _Lhs lhs;
+    _Rhs rhs;
+
+    constexpr std::size_t size() const { return std::min(lhs.size(), rhs.size()); }
+    constexpr value_type operator[](std::size_t i) const { return _Op{}(lhs[i], rhs[i]); }
+};
+
+// maps every kind of operand to the node representing it
+template<typename T, typename = void>
+struct node_of {};
+
+template<typename _Unit>
+struct node_of<unit_vector<_Unit>> {
+    using type = array_node<_Unit>;
+    static type make(const unit_vector<_Unit> &v) { return {v.begin(), v.size()}; }
+};
+
+template<typename _Unit>
+struct node_of<span<_Unit>, std::enable_if_t<is_unit<std::remove_const_t<_Unit>>::value>> {
+    using type = array_node<std::remove_const_t<_Unit>>;
+    static type make(const span<_Unit> &s) { return {s.data(), s.size()}; }
+};
+
+template<typename _Node>
+struct node_of<expression<_Node>> {
+    using type = _Node;
+    static type make(const expression<_Node> &e) { return e.node(); }
+};
+
+template<typename T>
+struct node_of<T, std::enable_if_t<is_unit<T>::value || std::is_arithmetic<T>::value>> {
+    using type = scalar_node<T>;
+    static type make(const T &v) { return {v}; }
+};
+
+template<typename T>
+using node_of_t = typename node_of<std::decay_t<T>>::type;
+
+template<typename T, typename = void>
+struct is_operand : std::false_type {};
+
+template<typename T>
+struct is_operand<T, std::void_t<node_of_t<T>>> : std::true_type {};
+
+template<typename _Lhs, typename _Rhs>
+struct has_array : std::integral_constant<bool, node_of_t<_Lhs>::is_array || node_of_t<_Rhs>::is_array> {};
+
+template<typename _Op, typename _Lhs, typename _Rhs, typename = void>
+struct is_valid_operation : std::false_type {};
+
+template<typename _Op, typename _Lhs, typename _Rhs>
+struct is_valid_operation<_Op, _Lhs, _Rhs,
+                          std::void_t<decltype(_Op{}(std::declval<typename node_of_t<_Lhs>::value_type>(),
+                                                     std::declval<typename node_of_t<_Rhs>::value_type>()))>>
+    : std::true_type {};
+
+// Only enabled when at least one of the sides is an array and the operation is valid
+// on their elements. The checks are made in this order, and stop at the first one
+// failing, so that operations on single units never look at the expression operators.
+template<typename _Op, typename _Lhs, typename _Rhs>
+using enable_expression = std::conjunction<is_operand<_Lhs>,
+                                           is_operand<_Rhs>,
+                                           has_array<_Lhs, _Rhs>,
+                                           is_valid_operation<_Op, _Lhs, _Rhs>>;
+
+template<typename _Op, typename _Lhs, typename _Rhs, bool = enable_expression<_Op, _Lhs, _Rhs>::value>
+struct expression_result {};
+
+template<typename _Op, typename _Lhs, typename _Rhs>
+struct expression_result<_Op, _Lhs, _Rhs, true> {
+    using type = expression<binary_node<_Op, node_of_t<_Lhs>, node_of_t<_Rhs>>>;
+};
+
+template<typename _Op, typename _Lhs, typename _Rhs>
+using expression_result_t = typename expression_result<_Op, std::decay_t<_Lhs>, std::decay_t<_Rhs>>::type;
+
+template<typename _Op, typename _Lhs, typename _Rhs>
+constexpr auto make_expression(const _Lhs &lhs, const _Rhs &rhs)
+{
+    using node = binary_node<_Op, node_of_t<_Lhs>, node_of_t<_Rhs>>;
+    auto n = node{node_of<_Lhs>::make(lhs), node_of<_Rhs>::make(rhs)};
+    assert(!node_of_t<_Lhs>::is_array || !node_of_t<_Rhs>::is_array
+           || n.lhs.size() == n.rhs.size());
+    return expression<node>{n};
+}
+
+// the single loop every expression is evaluated in
+template<typename _Unit, typename _Node>
+void evaluate_into(_Unit *out, const _Node &node, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = _Unit(node[i]);
+    }
+}
+} // namespace detail
+
+// An unevaluated element-wise operation on arrays of units. It only references its
+// operands, which need to outlive it.
+template<typename _Node>
+class expression
+{
+public:
+    using value_type = typename _Node::value_type;
+
+    constexpr explicit expression(const _Node &node)
+        : _node(node) { }
+
+    constexpr std::size_t size() const { return _node.size(); }
+    constexpr value_type operator[](std::size_t i) const { return _node[i]; }
+    constexpr const _Node &node() const { return _node; }
+
+private:
+    _Node _node;
+};
+
+template<typename _Lhs, typename _Rhs>
+constexpr auto operator+(const _Lhs &lhs, const _Rhs &rhs)
+    -> detail::expression_result_t<detail::plus, _Lhs, _Rhs>
+{
+    return detail::make_expression<detail::plus>(lhs, rhs);
+}
+
+template<typename _Lhs, typename _Rhs>
+constexpr auto operator-(const _Lhs &lhs, const _Rhs &rhs)
+    -> detail::expression_result_t<detail::minus, _Lhs, _Rhs>
+{
+    return detail::make_expression<detail::minus>(lhs, rhs);
+}
+
+template<typename _Lhs, typename _Rhs>
+constexpr auto operator*(const _Lhs &lhs, const _Rhs &rhs)
+    -> detail::expression_result_t<detail::multiplies, _Lhs, _Rhs>
+{
+    return detail::make_expression<detail::multiplies>(lhs, rhs);
+}
+
+template<typename _Lhs, typename _Rhs>
+constexpr auto operator/(const _Lhs &lhs, const _Rhs &rhs)
+    -> detail::expression_result_t<detail::divides, _Lhs, _Rhs>
+{
+    return detail::make_expression<detail::divides>(lhs, rhs);
+}
+
+// Evaluates the expression into out, converting every element to the unit of out,
+// with the same rules as the converting constructor of si::unit.
+template<typename _Unit, typename _Node>
+span<_Unit> assign(span<_Unit> out, const expression<_Node> &e)
+{
+    assert(out.size() >= e.size());
+    detail::evaluate_into(out.data(), e.node(), e.size());
+    return out.first(e.size());
+}
+
+template<typename _Unit, typename _Node>
+unit_vector<_Unit> &assign(unit_vector<_Unit> &out, const expression<_Node> &e)
+{
+    out.resize_for_overwrite(e.size());
+    detail::evaluate_into(out.begin(), e.node(), e.size());
+    return out;
+}
+
+// Evaluates the expression into a new unit_vector of its natural unit.
+template<typename _Node>
+unit_vector<typename expression<_Node>::value_type> evaluate(const expression<_Node> &e)
+{
+    unit_vector<typename expression<_Node>::value_type> result;
+    assign(result, e);
+    return result;
+}
+} // namespace si
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "si/core.hpp"
+#include "si/units.hpp"
+
+#include <cstdint>
+#include <ratio>
+
+// The units instantiated once by the compiled library, SI::SI_compiled: every
+// prefixed base unit of si/units.hpp and the unprefixed derived units, each with int,
+// float, double and int64_t counts (the derived units without int, which is their
+// rep only by default).
+//
+// Consumers linking SI::SI_compiled get SI_COMPILED defined, and si/units.hpp then
+// declares these instantiations extern, so that the members of the units are no
+// longer compiled and emitted by every translation unit that uses them. That only
+// pays off without optimisation: an optimising compiler instantiates them anyway to
+// inline them, and would only spend time on the declarations.
+// An explicit instantiation has to name si::unit itself rather than an alias of it.
+#define SI_FOR_EACH_PREFIX(X, dim, rep)                                                          \
+    X(si::unit<rep, std::atto, si::dim<rep>::base>) X(si::unit<rep, std::femto, si::dim<rep>::base>) \
+    X(si::unit<rep, std::pico, si::dim<rep>::base>) X(si::unit<rep, std::nano, si::dim<rep>::base>)  \
+    X(si::unit<rep, std::micro, si::dim<rep>::base>) X(si::unit<rep, std::milli, si::dim<rep>::base>) \
+    X(si::unit<rep, std::centi, si::dim<rep>::base>) X(si::unit<rep, std::deci, si::dim<rep>::base>) \
+    X(si::unit<rep, std::ratio<1>, si::dim<rep>::base>) X(si::unit<rep, std::deca, si::dim<rep>::base>) \
+    X(si::unit<rep, std::hecto, si::dim<rep>::base>) X(si::unit<rep, std::kilo, si::dim<rep>::base>) \
+    X(si::unit<rep, std::mega, si::dim<rep>::base>) X(si::unit<rep, std::giga, si::dim<rep>::base>) \
+    X(si::unit<rep, std::tera, si::dim<rep>::base>) X(si::unit<rep, std::peta, si::dim<rep>::base>) \
+    X(si::unit<rep, std::exa, si::dim<rep>::base>)
+
+#define SI_FOR_EACH_PREFIXED_UNIT(X, rep)                  \
+    SI_FOR_EACH_PREFIX(X, length, rep)                     \
+    SI_FOR_EACH_PREFIX(X, mass, rep)                       \
+    SI_FOR_EACH_PREFIX(X, time, rep)                       \
+    SI_FOR_EACH_PREFIX(X, current, rep)                    \
+    SI_FOR_EACH_PREFIX(X, temperature, rep)                \
+    SI_FOR_EACH_PREFIX(X, amount, rep)                     \
+    SI_FOR_EACH_PREFIX(X, luminous_intensity, rep)
+
+#define SI_DERIVED_UNIT(X, name, r) X(si::unit<si::name<r>::rep, si::name<r>::ratio, si::name<r>::base>)
+
+// the derived units that are distinct types: solid_angle is angle, radioactivity is
+// frequency, equivalent_dose is absorbed_dose and luminous_flux is luminous_intensity
+#define SI_FOR_EACH_DERIVED_UNIT(X, rep)                                                          \
+    SI_DERIVED_UNIT(X, area, rep) SI_DERIVED_UNIT(X, volume, rep)                                 \
+    SI_DERIVED_UNIT(X, velocity, rep) SI_DERIVED_UNIT(X, acceleration, rep)                       \
+    SI_DERIVED_UNIT(X, angle, rep) SI_DERIVED_UNIT(X, frequency, rep)                             \
+    SI_DERIVED_UNIT(X, force, rep) SI_DERIVED_UNIT(X, pressure, rep)                              \
+    SI_DERIVED_UNIT(X, energy, rep) SI_DERIVED_UNIT(X, power, rep)                                \
+    SI_DERIVED_UNIT(X, electric_charge, rep) SI_DERIVED_UNIT(X, voltage, rep)                     \
+    SI_DERIVED_UNIT(X, capacitance, rep) SI_DERIVED_UNIT(X, electric_resistance, rep)             \
+    SI_DERIVED_UNIT(X, electrical_conductance, rep) SI_DERIVED_UNIT(X, magnetic_flux, rep)        \
+    SI_DERIVED_UNIT(X, magnetic_flux_density, rep) SI_DERIVED_UNIT(X, inductance, rep)            \
+    SI_DERIVED_UNIT(X, illuminance, rep) SI_DERIVED_UNIT(X, absorbed_dose, rep)                   \
+    SI_DERIVED_UNIT(X, catalytic_activity, rep)
+
+#define SI_FOR_EACH_COMPILED_UNIT(X)                  \
+    SI_FOR_EACH_PREFIXED_UNIT(X, int)                 \
+    SI_FOR_EACH_PREFIXED_UNIT(X, float)               \
+    SI_FOR_EACH_PREFIXED_UNIT(X, double)              \
+    SI_FOR_EACH_PREFIXED_UNIT(X, std::int64_t)        \
+    SI_FOR_EACH_DERIVED_UNIT(X, float)                \
+    SI_FOR_EACH_DERIVED_UNIT(X, double)               \
+    SI_FOR_EACH_DERIVED_UNIT(X, std::int64_t)
+
+#if defined(SI_COMPILED) && !defined(__OPTIMIZE__)
+#define SI_EXTERN_UNIT(...) extern template struct __VA_ARGS__;
+SI_FOR_EACH_COMPILED_UNIT(SI_EXTERN_UNIT)
+#undef SI_EXTERN_UNIT
+#endif
@@ -0,0 +1,376 @@
+#pragma once
+
+#include "si/core.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// Binary fixed point representations, for cores where floating point is too slow in
+// the inner loops: an integer count with an implied scale of 2^-_FracBits.
+//
+// unit_cast folds that binary scale and the ratio of the conversion into a single
+// multiply by a constant followed by a single shift, or a division by a constant when
+// the ratio is not a power of two, rounded as the type says. Multiplications and
+// divisions of fixed point numbers of different scales are one multiply or divide and
+// one shift too.
+//
+//     using q16 = si::fixed<std::int32_t, 16>;
+//     si::length<q16, std::milli> mm{q16{1500}};
+//     si::length<q16> m = mm;                     // 1.5 m, a multiply and a shift
+namespace si
+{
+// How a fixed point value that does not fit the fractional bits of its type is rounded
+enum class rounding
+{
+    toward_zero, // as the conversions between integers do
+    down,        // toward minus infinity, a plain arithmetic shift
+    nearest,     // to the nearest value, halves up
+};
+
+template<typename _Int, int _FracBits, rounding _Rounding = rounding::nearest>
+class fixed;
+
+namespace detail
+{
+template<typename _Int, int _FracBits, rounding _Rounding>
+struct is_fixed<fixed<_Int, _FracBits, _Rounding>> : std::true_type {};
+
+// v / 2^_Shift, rounded
+template<rounding _Rounding, int _Shift, typename _W>
+constexpr _W round_shift(_W v)
+{
+    if constexpr (_Shift <= 0) {
+        return v * (_W{1} << -_Shift);
+    } else if constexpr (_Rounding == rounding::down) {
+        return v >> _Shift;
+    } else if constexpr (_Rounding == rounding::nearest) {
+        return (v + (_W{1} << (_Shift - 1))) >> _Shift;
+    } else {
+        return (v + (v < 0 ? (_W{1} << _Shift) - 1 : 0)) >> _Shift;
+    }
+}
+
+// a / b, rounded
+template<rounding _Rounding, typename _W>
+constexpr _W round_divide(_W a, _W b)
+{
+    if constexpr (_Rounding == rounding::toward_zero) {
+        return a / b;
+    } else {
+        if (b < 0) {
+            a = -a;
+            b = -b;
+        }
+        if constexpr (_Rounding == rounding::nearest) a = 2 * a + b, b = 2 * b;
+        const auto q = a / b;
+        return q - (a % b < 0 ? 1 : 0);
+    }
+}
+
+// x as an integer, rounded
+template<typename _Int, rounding _Rounding, typename _Real>
+constexpr _Int round_real(_Real x)
+{
+    if constexpr (_Rounding == rounding::nearest) x += _Real{0.5};
+    const auto t = static_cast<_Int>(x);
+    if constexpr (_Rounding == rounding::toward_zero) {
+        return t;
+    } else {
+        return x < static_cast<_Real>(t) ? t - 1 : t;
+    }
+}
+
+template<typename _Real>
+constexpr _Real exp2(int e)
+{
+    _Real r = 1;
+    for (; e > 0; --e) r *= 2;
+    for (; e < 0; ++e) r /= 2;
+    return r;
+}
+
+// what a fixed point conversion needs to know about both of its ends, integers being
+// fixed point numbers without fractional bits
+template<typename _Rep, rounding _Default = rounding::toward_zero>
+struct fixed_traits
+{
+    using int_type = _Rep;
+    static constexpr int frac_bits = 0;
+    static constexpr rounding round_mode = _Default;
+    static constexpr _Rep raw(_Rep count) { return count; }
+    static constexpr _Rep make(_Rep raw) { return raw; }
+};
+
+template<typename _Int, int _FracBits, rounding _Rounding, rounding _Default>
+struct fixed_traits<fixed<_Int, _FracBits, _Rounding>, _Default>
+{
+    using int_type = _Int;
+    static constexpr int frac_bits = _FracBits;
+    static constexpr rounding round_mode = _Rounding;
+    static constexpr _Int raw(const fixed<_Int, _FracBits, _Rounding> &count) { return count.raw(); }
+    static constexpr auto make(_Int raw) { return fixed<_Int, _FracBits, _Rounding>::from_raw(raw); }
+};
+
+// the integer the products of two raw values of these widths are computed in
+template<typename _Int1, typename _Int2>
+using fixed_work_t = std::conditional_t<(sizeof(_Int1) <= 4 && sizeof(_Int2) <= 4), std::int64_t, wide_int>;
+
+// _Num / _Den * 2^_Exp2 as a reduced multiplier / divisor, and the shift replacing
+// the divisor when it is a power of two
+struct fixed_scale
+{
+    wide_int multiplier;
+    wide_int divisor;
+    int shift;  // -1 when the divisor is not a power of two
+};
+
+template<wide_int _Num, wide_int _Den, int _Exp2>
+constexpr fixed_scale make_fixed_scale()
+{
+    wide_int num = _Num;
+    wide_int den = _Den;
+    if constexpr (_Exp2 >= 0) {
+        num *= wide_int{1} << _Exp2;
+    } else {
+        den *= wide_int{1} << -_Exp2;
+    }
+    while (num % 2 == 0 && den % 2 == 0) {
+        num /= 2;
+        den /= 2;
+    }
+
+    int shift = 0;
+    while ((wide_int{1} << shift) < den) ++shift;
+    return {num, den, (wide_int{1} << shift) == den ? shift : -1};
+}
+template<typename _ToRep, typename _Ratio, typename _Rep>
+constexpr _ToRep convert_fixed(const _Rep &count)
+{
+    constexpr auto num = _Ratio::num;
+    constexpr auto den = _Ratio::den;
+
+    if constexpr (treat_as_floating_point_v<_ToRep>) {
+        // the binary scale folded into the ratio, exactly since it is a power of two
+        using from = fixed_traits<_Rep>;
+        using real = arithmetic_t<_ToRep>;
+        constexpr auto factor = static_cast<real>(num) / static_cast<real>(den) * exp2<real>(-from::frac_bits);
+        return static_cast<_ToRep>(static_cast<real>(from::raw(count)) * factor);
+    } else if constexpr (treat_as_floating_point_v<_Rep>) {
+        using to = fixed_traits<_ToRep>;
+        using real = arithmetic_t<_Rep>;
+        constexpr auto factor = static_cast<real>(num) / static_cast<real>(den) * exp2<real>(to::frac_bits);
+        return to::make(round_real<typename to::int_type, to::round_mode>(static_cast<real>(count) * factor));
+    } else {
+        // integers round like the fixed point end of the conversion
+        using from = fixed_traits<_Rep>;
+        using to = fixed_traits<_ToRep, from::round_mode>;
+        using from_int = typename from::int_type;
+        using to_int = typename to::int_type;
+        static_assert(SI_HAS_INT128 || (sizeof(from_int) <= 4 && sizeof(to_int) <= 4),
+                      "64 bit fixed point conversions need 128 bit integers");
+
+        // A multiply by a constant, then a shift when the scale is a dyadic fraction, or
+        // else a division by a constant, which the compiler turns into a multiply and
+        // shifts. Unlike an approximate reciprocal, it is exact for every raw value.
+        // In 64 bits only when the product of any raw value by the multiplier fits in
+        // them, which a large ratio with a divisor other than a power of two defeats.
+        constexpr auto scale = make_fixed_scale<num, den, to::frac_bits - from::frac_bits>();
+        constexpr auto magnitude = scale.multiplier < 0 ? -scale.multiplier : scale.multiplier;
+        constexpr bool narrow = std::is_same<fixed_work_t<from_int, to_int>, std::int64_t>::value
+                             && magnitude <= (std::numeric_limits<std::int64_t>::max()
+                                              >> std::numeric_limits<from_int>::digits)
+                             && scale.divisor <= std::numeric_limits<std::int64_t>::max();
+        using work = std::conditional_t<narrow, std::int64_t, wide_int>;
+        const auto product = static_cast<work>(from::raw(count)) * static_cast<work>(scale.multiplier);
+        if constexpr (scale.shift >= 0) {
+            return to::make(static_cast<to_int>(round_shift<to::round_mode, scale.shift>(product)));
+        } else {
+            constexpr auto divisor = static_cast<work>(scale.divisor);
+            return to::make(static_cast<to_int>(round_divide<to::round_mode>(product, divisor)));
+        }
+    }
+}
+} // namespace detail
+
+// A fixed point number of _FracBits fractional bits held in the signed integer _Int.
+// Integers convert to it implicitly, floating point numbers and other fixed point types
+// explicitly, rounded as _Rounding says.
+template<typename _Int, int _FracBits, rounding _Rounding>
+class fixed
+{
+    static_assert(detail::is_integral_rep_v<_Int> && std::numeric_limits<_Int>::is_signed,
+                  "fixed point numbers are held in signed integers");
+    static_assert(_FracBits >= 0 && _FracBits < std::numeric_limits<_Int>::digits,
+                  "the fractional bits must leave room for the integral part");
+
+    static constexpr _Int one = _Int{1} << _FracBits;
+
+public:
+    using int_type = _Int;
+    static constexpr int frac_bits = _FracBits;
+    static constexpr rounding round_mode = _Rounding;
+
+    constexpr fixed() = default;
+
+    template<typename _I, class = std::enable_if_t<detail::is_integral_rep_v<_I>>>
+    constexpr fixed(_I value)
+        : _raw(static_cast<_Int>(static_cast<_Int>(value) * one)) { }
+
+    template<typename _F, class = std::enable_if_t<treat_as_floating_point_v<_F>>, class = void>
+    explicit constexpr fixed(_F value)
+        : _raw(detail::convert_fixed<fixed, std::ratio<1>>(value)._raw) { }
+
+    template<typename _Int2, int _FracBits2, rounding _Rounding2>
+    explicit constexpr fixed(const fixed<_Int2, _FracBits2, _Rounding2> &other)
+        : _raw(detail::convert_fixed<fixed, std::ratio<1>>(other)._raw) { }
+
+    static constexpr fixed from_raw(_Int raw)
+    {
+        fixed f;
+        f._raw = raw;
+        return f;
+    }
+
+    constexpr _Int raw() const { return _raw; }
+
+    template<typename _F, class = std::enable_if_t<treat_as_floating_point_v<_F>>>
+    explicit constexpr operator _F() const { return detail::convert_fixed<_F, std::ratio<1>>(*this); }
+
+    template<typename _I, class = std::enable_if_t<detail::is_integral_rep_v<_I>>, class = void>
+    explicit constexpr operator _I() const
+    {
+        return static_cast<_I>(detail::round_shift<_Rounding, _FracBits>(_raw));
+    }
+
+    constexpr fixed operator+() const { return *this; }
+    constexpr fixed operator-() const { return from_raw(static_cast<_Int>(-_raw)); }
+
+    constexpr fixed &operator+=(const fixed &rhs) { _raw += rhs._raw; return *this; }
+    constexpr fixed &operator-=(const fixed &rhs) { _raw -= rhs._raw; return *this; }
+    constexpr fixed &operator*=(const fixed &rhs) { return *this = *this * rhs; }
+    constexpr fixed &operator/=(const fixed &rhs) { return *this = *this / rhs; }
+
+    constexpr fixed &operator++() { _raw += one; return *this; }
+    constexpr fixed operator++(int) { const auto old = *this; _raw += one; return old; }
+    constexpr fixed &operator--() { _raw -= one; return *this; }
+    constexpr fixed operator--(int) { const auto old = *this; _raw -= one; return old; }
+
+    friend constexpr fixed operator+(const fixed &lhs, const fixed &rhs) { return from_raw(lhs._raw + rhs._raw); }
+    friend constexpr fixed operator-(const fixed &lhs, const fixed &rhs) { return from_raw(lhs._raw - rhs._raw); }
+
+    friend constexpr bool operator==(const fixed &lhs, const fixed &rhs) { return lhs._raw == rhs._raw; }
+    friend constexpr bool operator!=(const fixed &lhs, const fixed &rhs) { return lhs._raw != rhs._raw; }
+    friend constexpr bool operator<(const fixed &lhs, const fixed &rhs) { return lhs._raw < rhs._raw; }
+    friend constexpr bool operator<=(const fixed &lhs, const fixed &rhs) { return lhs._raw <= rhs._raw; }
+    friend constexpr bool operator>(const fixed &lhs, const fixed &rhs) { return lhs._raw > rhs._raw; }
+    friend constexpr bool operator>=(const fixed &lhs, const fixed &rhs) { return lhs._raw >= rhs._raw; }
+
+private:
+    _Int _raw = 0;
+};
+
+namespace detail
+{
+// with an integer, the fixed point type wide enough for it, with a floating point
+// number, the floating point type
+template<typename _Fixed, typename _T, typename = void>
+struct fixed_common {};
+
+template<typename _Int, int _FracBits, rounding _Rounding, typename _T>
+struct fixed_common<fixed<_Int, _FracBits, _Rounding>, _T, std::enable_if_t<is_integral_rep_v<_T>>>
+{
+    using type = fixed<std::common_type_t<_Int, _T>, _FracBits, _Rounding>;
+};
+
+template<typename _Fixed, typename _T>
+struct fixed_common<_Fixed, _T, std::enable_if_t<treat_as_floating_point_v<_T>>>
+{
+    using type = _T;
+};
+} // namespace detail
+} // namespace si
+
+namespace std
+{
+template<typename _Int1, int _FracBits1, si::rounding _Rounding1,
+         typename _Int2, int _FracBits2, si::rounding _Rounding2>
+struct common_type<si::fixed<_Int1, _FracBits1, _Rounding1>, si::fixed<_Int2, _FracBits2, _Rounding2>>
+{
+    using type = si::fixed<std::common_type_t<_Int1, _Int2>, (_FracBits1 > _FracBits2 ? _FracBits1 : _FracBits2),
+                           _Rounding1>;
+};
+
+template<typename _Int, int _FracBits, si::rounding _Rounding, typename _T>
+struct common_type<si::fixed<_Int, _FracBits, _Rounding>, _T>
+    : si::detail::fixed_common<si::fixed<_Int, _FracBits, _Rounding>, _T> {};
+
+template<typename _Int, int _FracBits, si::rounding _Rounding, typename _T>
+struct common_type<_T, si::fixed<_Int, _FracBits, _Rounding>>
+    : si::detail::fixed_common<si::fixed<_Int, _FracBits, _Rounding>, _T> {};
+} // namespace std
+
+namespace si
+{
+// The product and the quotient of fixed point numbers of different scales are
+// computed from the raw values in one multiply or divide and one rounded shift, in
+// the common type.
+template<typename _Int1, int _FracBits1, rounding _Rounding1,
+         typename _Int2, int _FracBits2, rounding _Rounding2>
+constexpr auto operator*(const fixed<_Int1, _FracBits1, _Rounding1> &lhs, const fixed<_Int2, _FracBits2, _Rounding2> &rhs)
+{
+    using result = std::common_type_t<fixed<_Int1, _FracBits1, _Rounding1>, fixed<_Int2, _FracBits2, _Rounding2>>;
+    using work = detail::fixed_work_t<_Int1, _Int2>;
+    constexpr int shift = _FracBits1 + _FracBits2 - result::frac_bits;
+    const auto product = static_cast<work>(lhs.raw()) * static_cast<work>(rhs.raw());
+    return result::from_raw(static_cast<typename result::int_type>(
+        detail::round_shift<result::round_mode, shift>(product)));
+}
+
+template<typename _Int1, int _FracBits1, rounding _Rounding1,
+         typename _Int2, int _FracBits2, rounding _Rounding2>
+constexpr auto operator/(const fixed<_Int1, _FracBits1, _Rounding1> &lhs, const fixed<_Int2, _FracBits2, _Rounding2> &rhs)
+{
+    using result = std::common_type_t<fixed<_Int1, _FracBits1, _Rounding1>, fixed<_Int2, _FracBits2, _Rounding2>>;
+    using work = detail::fixed_work_t<_Int1, _Int2>;
+    constexpr int shift = result::frac_bits + _FracBits2 - _FracBits1;
+    const auto dividend = detail::round_shift<result::round_mode, -shift>(static_cast<work>(lhs.raw()));
+    return result::from_raw(static_cast<typename result::int_type>(
+        detail::round_divide<result::round_mode>(dividend, static_cast<work>(rhs.raw()))));
+}
+
+// with integers, the raw value is multiplied or divided as is
+template<typename _Int, int _FracBits, rounding _Rounding, typename _I,
+         class = std::enable_if_t<detail::is_integral_rep_v<_I>>>
+constexpr auto operator*(const fixed<_Int, _FracBits, _Rounding> &lhs, const _I &rhs)
+{
+    using result = std::common_type_t<fixed<_Int, _FracBits, _Rounding>, _I>;
+    using int_type = typename result::int_type;
+    return result::from_raw(static_cast<int_type>(static_cast<int_type>(lhs.raw()) * static_cast<int_type>(rhs)));
+}
+
+template<typename _Int, int _FracBits, rounding _Rounding, typename _I,
+         class = std::enable_if_t<detail::is_integral_rep_v<_I>>>
+constexpr auto operator*(const _I &lhs, const fixed<_Int, _FracBits, _Rounding> &rhs)
+{
+    return rhs * lhs;
+}
+
+template<typename _Int, int _FracBits, rounding _Rounding, typename _I,
+         class = std::enable_if_t<detail::is_integral_rep_v<_I>>>
+constexpr auto operator/(const fixed<_Int, _FracBits, _Rounding> &lhs, const _I &rhs)
+{
+    using result = std::common_type_t<fixed<_Int, _FracBits, _Rounding>, _I>;
+    using int_type = typename result::int_type;
+    using work = detail::fixed_work_t<int_type, int_type>;
+    return result::from_raw(static_cast<int_type>(
+        detail::round_divide<_Rounding>(static_cast<work>(lhs.raw()), static_cast<work>(rhs))));
+}
+
+template<typename _Int, int _FracBits, rounding _Rounding, typename _I,
+         class = std::enable_if_t<detail::is_integral_rep_v<_I>>>
+constexpr auto operator/(const _I &lhs, const fixed<_Int, _FracBits, _Rounding> &rhs)
+{
+    return fixed<_Int, 0, _Rounding>::from_raw(static_cast<_Int>(lhs)) / rhs;
+}
+} // namespace si
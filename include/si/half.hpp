@@ -0,0 +1,166 @@
+#pragma once
+
+#include "si/convert.hpp"
+#include "si/core.hpp"
+#include "si/span.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// 16 bit floating point representations, for arrays of units that need only about
+// three significant digits and are limited by memory bandwidth.
+//
+// si::float16_t is the IEEE 754 half precision type of the compiler, where there is
+// one, si::bfloat16 the upper half of a float, with its range but 8 bits of precision.
+// Both are storage formats: arithmetic on them is done in float, and arrays of them are
+// best converted to float in bulk with si::widen and back with si::narrow.
+//
+//     std::vector<si::length<si::bfloat16>> stored = ...;
+//     std::vector<si::length<float>> lengths(stored.size());
+//     si::widen(si::span<const si::length<si::bfloat16>>{stored}, si::span<si::length<float>>{lengths});
+namespace si
+{
+class bfloat16
+{
+public:
+    constexpr bfloat16() = default;
+
+    // rounded to nearest even, NaNs stay NaNs
+    constexpr bfloat16(float value)
+        : _bits(round(__builtin_bit_cast(std::uint32_t, value))) { }
+
+    constexpr operator float() const { return __builtin_bit_cast(float, static_cast<std::uint32_t>(_bits) << 16); }
+
+    static constexpr bfloat16 from_bits(std::uint16_t bits)
+    {
+        bfloat16 b;
+        b._bits = bits;
+        return b;
+    }
+
+    constexpr std::uint16_t bits() const { return _bits; }
+
+    constexpr bfloat16 operator-() const { return from_bits(static_cast<std::uint16_t>(_bits ^ 0x8000)); }
+    constexpr bfloat16 operator+() const { return *this; }
+
+    constexpr bfloat16 &operator+=(float rhs) { return *this = bfloat16{float(*this) + rhs}; }
+    constexpr bfloat16 &operator-=(float rhs) { return *this = bfloat16{float(*this) - rhs}; }
+    constexpr bfloat16 &operator*=(float rhs) { return *this = bfloat16{float(*this) * rhs}; }
+    constexpr bfloat16 &operator/=(float rhs) { return *this = bfloat16{float(*this) / rhs}; }
+
+    constexpr bfloat16 &operator++() { return *this += 1.0f; }
+    constexpr bfloat16 operator++(int) { const auto old = *this; ++*this; return old; }
+    constexpr bfloat16 &operator--() { return *this -= 1.0f; }
+    constexpr bfloat16 operator--(int) { const auto old = *this; --*this; return old; }
+
+private:
+    // Without a branch, so that loops narrowing arrays vectorise: adding 0x7fff plus the
+    // lowest kept bit rounds to nearest even, a NaN is made quiet instead so that the
+    // rounding cannot carry it into an infinity.
+    static constexpr std::uint16_t round(std::uint32_t bits)
+    {
+        const auto rounded = (bits + 0x7fff + ((bits >> 16) & 1)) >> 16;
+        const auto nan = (bits >> 16) | 0x40;
+        return static_cast<std::uint16_t>((bits & 0x7fffffff) > 0x7f800000 ? nan : rounded);
+    }
+
+    std::uint16_t _bits = 0;
+};
+
+template<>
+struct treat_as_floating_point<bfloat16> : std::true_type {};
+
+namespace detail
+{
+template<typename _Rep>
+inline constexpr bool is_half_v = treat_as_floating_point_v<_Rep> && sizeof(_Rep) == 2;
+
+// bfloat16 converts both to and from float, which makes the conditional operator the
+// default std::common_type relies on ambiguous. As for the built-in types, the common
+// type is the wider floating point type, bfloat16 with an integer, and float with the
+// other half precision type.
+template<typename _T, typename = void>
+struct bfloat16_common {};
+
+template<typename _T>
+struct bfloat16_common<_T, std::enable_if_t<is_integral_rep_v<_T>>> { using type = bfloat16; };
+
+template<typename _T>
+struct bfloat16_common<_T, std::enable_if_t<treat_as_floating_point_v<_T>>>
+{
+    using type = std::conditional_t<is_half_v<_T>, float, _T>;
+};
+} // namespace detail
+
+// Converts every unit of `in` to float, `out` must be at least as large as `in`. The
+// conversion is exact, and vectorised like si::convert.
+template<typename _Rep, typename _Ratio, typename _Base,
+         class = std::enable_if_t<detail::is_half_v<_Rep>>>
+span<unit<float, _Ratio, _Base>> widen(span<const unit<_Rep, _Ratio, _Base>> in,
+                                       span<unit<float, _Ratio, _Base>> out)
+{
+    return convert(in, out);
+}
+
+// Rounds every unit of `in` to the nearest 16 bit floating point number, `out` must be
+// at least as large as `in`.
+template<typename _Rep, typename _Ratio, typename _Base,
+         class = std::enable_if_t<detail::is_half_v<_Rep>>>
+span<unit<_Rep, _Ratio, _Base>> narrow(span<const unit<float, _Ratio, _Base>> in,
+                                       span<unit<_Rep, _Ratio, _Base>> out)
+{
+    return convert(in, out);
+}
+} // namespace si
+
+namespace std
+{
+template<>
+class numeric_limits<si::bfloat16>
+{
+public:
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = true;
+    static constexpr bool is_integer = false;
+    static constexpr bool is_exact = false;
+    static constexpr bool has_infinity = true;
+    static constexpr bool has_quiet_NaN = true;
+    static constexpr bool has_signaling_NaN = true;
+    static constexpr float_denorm_style has_denorm = denorm_present;
+    static constexpr bool has_denorm_loss = false;
+    static constexpr float_round_style round_style = round_to_nearest;
+    static constexpr bool is_iec559 = false;
+    static constexpr bool is_bounded = true;
+    static constexpr bool is_modulo = false;
+    static constexpr int digits = 8;
+    static constexpr int digits10 = 2;
+    static constexpr int max_digits10 = 4;
+    static constexpr int radix = 2;
+    static constexpr int min_exponent = -125;
+    static constexpr int min_exponent10 = -37;
+    static constexpr int max_exponent = 128;
+    static constexpr int max_exponent10 = 38;
+    static constexpr bool traps = false;
+    static constexpr bool tinyness_before = false;
+
+    static constexpr si::bfloat16 min() noexcept { return si::bfloat16::from_bits(0x0080); }
+    static constexpr si::bfloat16 lowest() noexcept { return si::bfloat16::from_bits(0xff7f); }
+    static constexpr si::bfloat16 max() noexcept { return si::bfloat16::from_bits(0x7f7f); }
+    static constexpr si::bfloat16 epsilon() noexcept { return si::bfloat16::from_bits(0x3c00); }
+    static constexpr si::bfloat16 round_error() noexcept { return si::bfloat16::from_bits(0x3f00); }
+    static constexpr si::bfloat16 infinity() noexcept { return si::bfloat16::from_bits(0x7f80); }
+    static constexpr si::bfloat16 quiet_NaN() noexcept { return si::bfloat16::from_bits(0x7fc0); }
+    static constexpr si::bfloat16 signaling_NaN() noexcept { return si::bfloat16::from_bits(0x7fa0); }
+    static constexpr si::bfloat16 denorm_min() noexcept { return si::bfloat16::from_bits(0x0001); }
+};
+
+template<>
+struct common_type<si::bfloat16, si::bfloat16> { using type = si::bfloat16; };
+
+template<typename _T>
+struct common_type<si::bfloat16, _T> : si::detail::bfloat16_common<_T> {};
+
+template<typename _T>
+struct common_type<_T, si::bfloat16> : si::detail::bfloat16_common<_T> {};
+} // namespace std
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "si/charconv.hpp"
+#include "si/core.hpp"
+
+#include <ostream>
+
+// Stream output of units, kept out of si/core.hpp so that only the translation
+// units actually printing units pay for <ostream>.
+namespace si
+{
+// writes the unit as si::to_chars does, for instance "3 km" or "2 kg·m·s⁻²"
+template<typename _Rep, typename _Ratio, typename _Base>
+std::ostream &operator<<(std::ostream &os, const unit<_Rep, _Ratio, _Base> &u)
+{
+    char buffer[128];
+    auto r = to_chars(buffer, buffer + sizeof(buffer), u);
+    return os.write(buffer, r.ptr - buffer);
+}
+} // namespace si
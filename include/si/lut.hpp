@@ -0,0 +1,243 @@
+#pragma once
+
+#include "si/convert.hpp"
+#include "si/core.hpp"
+#include "si/span.hpp"
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <ratio>
+#include <type_traits>
+
+// Lookup tables of units sampled at uniformly spaced inputs, such as the calibration of
+// a sensor mapping a temperature to a voltage, interpolated linearly or with cubic
+// Catmull-Rom splines.
+//
+// The spacing being uniform, the position of an input in the table is a multiply and an
+// add rather than a search. The ratio between the input and the inputs of the table is
+// folded into the factor at compile time, so that inputs of any prefix cost the same,
+// and an input of another dimension does not compile. Inputs outside the table are
+// clamped to its ends, the table is extrapolated linearly for the splines of its ends.
+// Inputs must not be NaN.
+//
+// Arrays are evaluated with the instruction set selected at runtime by si::convert,
+// which gathers the entries of the table in vectors from avx2 on.
+//
+//     const si::lut<si::temperature<double>, si::voltage<double, std::milli>, 3> calibration{
+//         si::temperature<double>{250}, si::temperature<double>{350},
+//         {si::voltage<double, std::milli>{10}, si::voltage<double, std::milli>{14}, ...}};
+//     auto v = calibration(si::temperature<int, std::milli>{293150});
+//     calibration.cubic(si::span<const si::temperature<double>>{temperatures},
+//                       si::span<si::voltage<double, std::milli>>{voltages});
+namespace si
+{
+template<typename _XUnit, typename _YUnit, std::size_t _N>
+class lut;
+
+namespace detail
+{
+template<bool _Cubic, typename _Lut, typename _X>
+typename _Lut::y_type lut_evaluate(const _Lut &table, const _X &x)
+{
+    if constexpr (_Cubic) {
+        return table.cubic(x);
+    } else {
+        return table.linear(x);
+    }
+}
+
+// blocked like the conversion kernels, so that the inner loop vectorizes at -O2
+#define SI_LUT_KERNEL_BODY                                              \
+    constexpr std::size_t block = 16;                                   \
+    std::size_t i = 0;                                                  \
+    for (; i + block <= n; i += block) {                                \
+        for (std::size_t j = 0; j < block; ++j) {                       \
+            out[i + j] = lut_evaluate<_Cubic>(table, in[i + j]);        \
+        }                                                               \
+    }                                                                   \
+    for (; i < n; ++i) {                                                \
+        out[i] = lut_evaluate<_Cubic>(table, in[i]);                    \
+    }
+
+template<bool _Cubic, typename _Lut, typename _X>
+void lut_scalar(const _Lut &table, const _X *__restrict in, typename _Lut::y_type *__restrict out, std::size_t n)
+{
+    SI_LUT_KERNEL_BODY
+}
+
+#if SI_CONVERT_X86_DISPATCH
+template<bool _Cubic, typename _Lut, typename _X>
+__attribute__((target("avx2,fma,f16c")))
+void lut_avx2(const _Lut &table, const _X *__restrict in, typename _Lut::y_type *__restrict out, std::size_t n)
+{
+    SI_LUT_KERNEL_BODY
+}
+
+template<bool _Cubic, typename _Lut, typename _X>
+__attribute__((target("avx512f,avx512bw,avx512vl,avx512dq,f16c,prefer-vector-width=512")))
+void lut_avx512(const _Lut &table, const _X *__restrict in, typename _Lut::y_type *__restrict out, std::size_t n)
+{
+    SI_LUT_KERNEL_BODY
+}
+#endif
+
+#undef SI_LUT_KERNEL_BODY
+
+template<bool _Cubic, typename _Lut, typename _X>
+void lut_batch(const _Lut &table, const _X *in, typename _Lut::y_type *out, std::size_t n)
+{
+#if SI_CONVERT_X86_DISPATCH
+    switch (native_isa()) {
+    case isa::avx512dq:
+        lut_avx512<_Cubic>(table, in, out, n);
+        return;
+    case isa::avx512:
+    case isa::avx2:
+        lut_avx2<_Cubic>(table, in, out, n);
+        return;
+    case isa::sse2:
+    case isa::scalar:
+        break;
+    }
+#endif
+    lut_scalar<_Cubic>(table, in, out, n);
+}
+} // namespace detail
+
+// The values of _YUnit at _N inputs of _XUnit spaced uniformly from first to last
+template<typename _XUnit, typename _YUnit, std::size_t _N>
+class lut
+{
+    static_assert(detail::is_unit<_XUnit>::value && detail::is_unit<_YUnit>::value, "a table maps units to units");
+    static_assert(_N >= 2 && _N < (1u << 30), "a table has at least 2 entries");
+
+public:
+    using x_type = _XUnit;
+    using y_type = _YUnit;
+    // interpolation is computed in the floating point representation of the values, in double otherwise
+    using real   = std::conditional_t<treat_as_floating_point_v<typename _YUnit::rep>,
+                                      detail::arithmetic_t<typename _YUnit::rep>, double>;
+
+    static constexpr std::size_t size() noexcept { return _N; }
+
+    constexpr lut(const _XUnit &first, const _XUnit &last, const std::array<_YUnit, _N> &values)
+        : _first(first), _last(last)
+    {
+        assert(first < last);
+        const auto x0 = static_cast<real>(first.count());
+        _scale = static_cast<real>(_N - 1) / (static_cast<real>(last.count()) - x0);
+        _offset = x0 * _scale;
+        for (std::size_t i = 0; i < _N; ++i) _y[i + 1] = static_cast<real>(values[i].count());
+        _y[0] = 2 * _y[1] - _y[2];
+        _y[_N + 1] = 2 * _y[_N] - _y[_N - 1];
+    }
+
+    constexpr _XUnit first() const noexcept { return _first; }
+    constexpr _XUnit last() const noexcept { return _last; }
+
+    template<typename _Rep, typename _Ratio, typename _Base>
+    constexpr _YUnit operator()(const unit<_Rep, _Ratio, _Base> &x) const
+    {
+        return linear(x);
+    }
+
+    template<typename _Rep, typename _Ratio, typename _Base>
+    constexpr _YUnit linear(const unit<_Rep, _Ratio, _Base> &x) const
+    {
+        const real p = position(x);
+        const int i = index(p);
+        const real t = p - static_cast<real>(i);
+        const real y0 = _y[i + 1];
+        const real y1 = _y[i + 2];
+        return value(y0 + t * (y1 - y0));
+    }
+
+    template<typename _Rep, typename _Ratio, typename _Base>
+    constexpr _YUnit cubic(const unit<_Rep, _Ratio, _Base> &x) const
+    {
+        const real p = position(x);
+        const int i = index(p);
+        const real t = p - static_cast<real>(i);
+        const real y0 = _y[i];
+        const real y1 = _y[i + 1];
+        const real y2 = _y[i + 2];
+        const real y3 = _y[i + 3];
+        return value(y1 + real{0.5} * t * (y2 - y0 + t * (2 * y0 - 5 * y1 + 4 * y2 - y3 + t * (3 * (y1 - y2) + y3 - y0))));
+    }
+
+    // Evaluates every input of `in` into the corresponding element of `out`, which must
+    // be at least as large, and returns the part of `out` that was written to
+    template<typename _Rep, typename _Ratio, typename _Base>
+    span<_YUnit> linear(span<const unit<_Rep, _Ratio, _Base>> in, span<_YUnit> out) const
+    {
+        assert(out.size() >= in.size());
+        detail::lut_batch<false>(*this, in.data(), out.data(), in.size());
+        return out.first(in.size());
+    }
+
+    template<typename _Rep, typename _Ratio, typename _Base>
+    span<_YUnit> linear(span<unit<_Rep, _Ratio, _Base>> in, span<_YUnit> out) const
+    {
+        return linear(span<const unit<_Rep, _Ratio, _Base>>{in}, out);
+    }
+
+    template<typename _Rep, typename _Ratio, typename _Base>
+    span<_YUnit> cubic(span<const unit<_Rep, _Ratio, _Base>> in, span<_YUnit> out) const
+    {
+        assert(out.size() >= in.size());
+        detail::lut_batch<true>(*this, in.data(), out.data(), in.size());
+        return out.first(in.size());
+    }
+
+    template<typename _Rep, typename _Ratio, typename _Base>
+    span<_YUnit> cubic(span<unit<_Rep, _Ratio, _Base>> in, span<_YUnit> out) const
+    {
+        return cubic(span<const unit<_Rep, _Ratio, _Base>>{in}, out);
+    }
+
+private:
+    // the position of x in the table, from 0 to _N - 1
+    template<typename _Rep, typename _Ratio, typename _Base>
+    constexpr real position(const unit<_Rep, _Ratio, _Base> &x) const
+    {
+        static_assert(std::is_same<_Base, typename _XUnit::base>::value, "the input does not have the dimension of the table");
+        using factor = std::ratio_divide<_Ratio, typename _XUnit::ratio>;
+        constexpr real fold = static_cast<real>(factor::num) / static_cast<real>(factor::den);
+
+        const real p = static_cast<real>(x.count()) * (fold * _scale) - _offset;
+        // clamped without comparisons, which keep GCC from vectorizing along with the
+        // conversion of the index unless floating point exceptions are disabled
+        constexpr real end = static_cast<real>(_N - 1);
+        const real above = real{0.5} * (p + std::fabs(p));
+        return real{0.5} * (above + end - std::fabs(above - end));
+    }
+
+    // the entry before p, the one before the last for the last one
+    static constexpr int index(real p) noexcept
+    {
+        const int i = static_cast<int>(p);
+        const int below = i < static_cast<int>(_N - 2) ? i : static_cast<int>(_N - 2);
+        return below > 0 ? below : 0;
+    }
+
+    // integral values are rounded to the nearest, halves away from zero
+    static constexpr _YUnit value(real count) noexcept
+    {
+        using rep = typename _YUnit::rep;
+        if constexpr (detail::is_integral_rep_v<rep>) {
+            return _YUnit{static_cast<rep>(count < 0 ? count - real{0.5} : count + real{0.5})};
+        } else {
+            return _YUnit{static_cast<rep>(count)};
+        }
+    }
+
+    _XUnit _first;
+    _XUnit _last;
+    real _scale = 0;
+    real _offset = 0;
+    // the values with one more extrapolated at both ends
+    std::array<real, _N + 2> _y{};
+};
+} // namespace si
@@ -0,0 +1,354 @@
+#pragma once
+
+#include "si/core.hpp"
+#include "si/span.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<execution>)
+#include <execution>
+#endif
+
+#if defined(__cpp_lib_execution)
+#define SI_HAS_EXECUTION 1
+#else
+#define SI_HAS_EXECUTION 0
+#endif
+
+// Reductions over contiguous ranges of units: si::sum, si::mean, si::dot, si::min_max
+// and the general si::reduce. Each has an overload taking a std::execution policy,
+// which splits the range into chunks reduced by separate tasks.
+//
+// Sums are not accumulated in the representation of the units but in si::sum_rep_t of
+// it: floating point sums are compensated, so that their error does not grow with the
+// length of the range, and integers are summed in 64 or 128 bits, so that they do not
+// overflow.
+//
+//     std::vector<si::energy<float>> readings = ...;
+//     si::energy<float> total = si::sum(std::execution::par, readings);
+//     si::energy<double> work = si::dot(forces, distances);
+//
+// With libstdc++ the parallel policies run on TBB, which has to be linked when its
+// headers are installed, and on a single thread otherwise. The compensation relies on
+// strict floating point semantics, it is optimised away by -ffast-math.
+namespace si
+{
+// The representation sums of _Rep are accumulated in and returned as. Specialise it
+// for representations of your own.
+template<typename _Rep, typename = void>
+struct sum_rep { using type = _Rep; };
+
+template<typename _Rep>
+using sum_rep_t = typename sum_rep<_Rep>::type;
+
+template<typename _Rep>
+struct sum_rep<_Rep, std::enable_if_t<treat_as_floating_point_v<_Rep>>>
+{
+    using type = detail::arithmetic_t<_Rep>;
+};
+
+template<typename _Rep>
+struct sum_rep<_Rep, std::enable_if_t<detail::is_integral_rep_v<_Rep>>>
+{
+#if SI_HAS_INT128
+    using wide_uint = uint128_t;
+#else
+    using wide_uint = std::uintmax_t;
+#endif
+    static constexpr bool is_signed = static_cast<_Rep>(-1) < _Rep{0};
+
+    using type = std::conditional_t<(sizeof(_Rep) < sizeof(std::int64_t)),
+                                    std::conditional_t<is_signed, std::int64_t, std::uint64_t>,
+                                    std::conditional_t<is_signed, detail::wide_int, wide_uint>>;
+};
+
+template<typename _Unit>
+struct min_max_result
+{
+    _Unit min;
+    _Unit max;
+};
+
+namespace detail
+{
+template<typename _Range>
+using range_unit_t = std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(std::declval<const _Range &>()))>>;
+
+// Ranges of units in contiguous storage, such as an array, std::vector, si::span or
+// si::unit_vector, which all convert to a si::span of their units. std::list or
+// std::deque do not, their elements are not one array.
+template<typename _Range>
+using enable_if_unit_range_t = std::enable_if_t<std::conjunction<
+    is_unit<range_unit_t<_Range>>, std::is_convertible<const _Range &, span<const range_unit_t<_Range>>>>::value>;
+
+template<typename _Range>
+span<const range_unit_t<_Range>> units_of(const _Range &range)
+{
+    return range;
+}
+
+template<typename _Unit>
+using sum_unit_t = unit<sum_rep_t<typename _Unit::rep>, typename _Unit::ratio, typename _Unit::base>;
+
+template<typename _Unit>
+using mean_unit_t = unit<std::conditional_t<is_integral_rep_v<typename _Unit::rep>, double, sum_rep_t<typename _Unit::rep>>,
+                         typename _Unit::ratio, typename _Unit::base>;
+
+// the unit of the products as operator* computes it, with the sum representation of its rep
+template<typename _Unit1, typename _Unit2>
+using dot_unit_t = unit<sum_rep_t<std::common_type_t<typename _Unit1::rep, typename _Unit2::rep>>,
+                        std::common_type_t<typename _Unit1::ratio, typename _Unit2::ratio>,
+                        base_multiply<typename _Unit1::base, typename _Unit2::base>>;
+
+// Neumaier's variant of Kahan summation: the rounding error of every addition is summed
+// separately and added back at the end, which unlike Kahan's also holds when the value
+// added is larger than the sum so far. The error is computed with Knuth's two-sum, which
+// gives the same exact error as Neumaier's comparison of magnitudes without a branch,
+// so that the lanes below vectorise.
+template<typename _Real>
+struct compensated_sum
+{
+    _Real sum = 0;
+    _Real error = 0;
+
+    void add(_Real x)
+    {
+        const _Real t = sum + x;
+        const _Real z = t - sum;
+        error += (sum - (t - z)) + (x - z);
+        sum = t;
+    }
+
+    void merge(const compensated_sum &other)
+    {
+        add(other.sum);
+        error += other.error;
+    }
+
+    _Real value() const { return sum + error; }
+};
+
+template<typename _Acc>
+struct plain_sum
+{
+    _Acc sum = 0;
+
+    void add(_Acc x) { sum += x; }
+    void merge(const plain_sum &other) { sum += other.sum; }
+    _Acc value() const { return sum; }
+};
+
+template<typename _Acc>
+using accumulator_t = std::conditional_t<treat_as_floating_point_v<_Acc>, compensated_sum<_Acc>, plain_sum<_Acc>>;
+
+template<typename _Rep>
+struct min_max_accumulator
+{
+    _Rep min;
+    _Rep max;
+
+    void add(_Rep x)
+    {
+        min = x < min ? x : min;
+        max = max < x ? x : max;
+    }
+
+    void merge(const min_max_accumulator &other)
+    {
+        add(other.min);
+        add(other.max);
+    }
+};
+
+template<typename _Acc>
+struct merge_accumulators
+{
+    _Acc operator()(_Acc lhs, const _Acc &rhs) const
+    {
+        lhs.merge(rhs);
+        return lhs;
+    }
+};
+
+// Every element of a block is added to an accumulator of its own, these independent
+// lanes let the compiler vectorise the loop without reordering any floating point
+// addition, and hide the latency of the compensation.
+constexpr std::size_t reduce_lanes = 16;
+
+template<typename _Acc, typename _Term>
+_Acc accumulate(std::size_t first, std::size_t n, const _Acc &init, _Term term)
+{
+    _Acc total = init;
+    std::size_t i = 0;
+    if (n >= reduce_lanes) {
+        _Acc lanes[reduce_lanes];
+        std::fill(std::begin(lanes), std::end(lanes), init);
+        // bounded by a multiple of the block rather than by i + reduce_lanes <= n, which
+        // GCC cannot prove does not wrap, and then warns of the loop running forever
+        for (const auto blocks_end = n - n % reduce_lanes; i < blocks_end; i += reduce_lanes) {
+            for (std::size_t j = 0; j < reduce_lanes; ++j) {
+                lanes[j].add(term(first + i + j));
+            }
+        }
+        for (const auto &lane : lanes) total.merge(lane);
+    }
+    for (; i < n; ++i) total.add(term(first + i));
+    return total;
+}
+
+#if SI_HAS_EXECUTION
+// the number of elements reduced by a single task, large enough for the vectorised loop
+// to dominate the cost of scheduling it
+constexpr std::size_t reduce_chunk = std::size_t{1} << 16;
+
+template<typename _Policy, typename _Acc, typename _Term>
+_Acc accumulate(_Policy &&policy, std::size_t first, std::size_t n, const _Acc &init, _Term term)
+{
+    if (n <= reduce_chunk) return accumulate(first, n, init, term);
+
+    std::vector<std::size_t> chunks((n + reduce_chunk - 1) / reduce_chunk);
+    for (std::size_t i = 0; i < chunks.size(); ++i) chunks[i] = i * reduce_chunk;
+    return std::transform_reduce(std::forward<_Policy>(policy), chunks.begin(), chunks.end(), init,
+                                 merge_accumulators<_Acc>{}, [&](std::size_t offset) {
+                                     return accumulate(first + offset, std::min(reduce_chunk, n - offset), init, term);
+                                 });
+}
+
+template<typename _Policy>
+using enable_if_execution_policy_t = std::enable_if_t<std::is_execution_policy<std::decay_t<_Policy>>::value>;
+#endif
+
+template<typename _Unit, typename... _Policy>
+sum_unit_t<_Unit> sum(span<const _Unit> in, _Policy &&...policy)
+{
+    using rep = sum_rep_t<typename _Unit::rep>;
+    const auto *data = in.data();
+    const auto total = accumulate(std::forward<_Policy>(policy)..., 0, in.size(), accumulator_t<rep>{},
+                                  [data](std::size_t i) { return static_cast<rep>(data[i].count()); });
+    return sum_unit_t<_Unit>{total.value()};
+}
+
+template<typename _Unit, typename... _Policy>
+mean_unit_t<_Unit> mean(span<const _Unit> in, _Policy &&...policy)
+{
+    using result = mean_unit_t<_Unit>;
+    using rep = typename result::rep;
+    const auto total = sum(in, std::forward<_Policy>(policy)...);
+    return result{static_cast<rep>(total.count()) / static_cast<rep>(in.size())};
+}
+
+template<typename _Unit1, typename _Unit2, typename... _Policy>
+dot_unit_t<_Unit1, _Unit2> dot(span<const _Unit1> lhs, span<const _Unit2> rhs, _Policy &&...policy)
+{
+    using rep = typename dot_unit_t<_Unit1, _Unit2>::rep;
+    assert(lhs.size() == rhs.size());
+    const auto *a = lhs.data();
+    const auto *b = rhs.data();
+    const auto total = accumulate(std::forward<_Policy>(policy)..., 0, lhs.size(), accumulator_t<rep>{},
+                                  [a, b](std::size_t i) {
+                                      return static_cast<rep>(static_cast<rep>(a[i].count()) * static_cast<rep>(b[i].count()));
+                                  });
+    return dot_unit_t<_Unit1, _Unit2>{total.value()};
+}
+
+template<typename _Unit, typename... _Policy>
+min_max_result<_Unit> min_max(span<const _Unit> in, _Policy &&...policy)
+{
+    using rep = typename _Unit::rep;
+    assert(!in.empty());
+    const auto *data = in.data();
+    const auto first = data[0].count();
+    const auto extremes = accumulate(std::forward<_Policy>(policy)..., 0, in.size(), min_max_accumulator<rep>{first, first},
+                                     [data](std::size_t i) { return data[i].count(); });
+    return {_Unit{extremes.min}, _Unit{extremes.max}};
+}
+} // namespace detail
+
+// The sum of the units of `range`, compensated for floating point representations and
+// in a wider integer for integral ones. The sum of an empty range is zero.
+template<typename _Range, class = detail::enable_if_unit_range_t<_Range>>
+auto sum(const _Range &range)
+{
+    return detail::sum(detail::units_of(range));
+}
+
+// The arithmetic mean of the units of `range`, in floating point for integral
+// representations. The mean of an empty range is NaN.
+template<typename _Range, class = detail::enable_if_unit_range_t<_Range>>
+auto mean(const _Range &range)
+{
+    return detail::mean(detail::units_of(range));
+}
+
+// The sum of the products of the units of `lhs` and `rhs`, which must have the same
+// size, in the unit of their product: the dot product of forces and lengths is energy.
+// The products are computed, and summed, in si::sum_rep_t of their representation.
+template<typename _Range1, typename _Range2,
+         class = detail::enable_if_unit_range_t<_Range1>, class = detail::enable_if_unit_range_t<_Range2>>
+auto dot(const _Range1 &lhs, const _Range2 &rhs)
+{
+    return detail::dot(detail::units_of(lhs), detail::units_of(rhs));
+}
+
+// The smallest and the largest unit of `range`, which must not be empty
+template<typename _Range, class = detail::enable_if_unit_range_t<_Range>>
+auto min_max(const _Range &range)
+{
+    return detail::min_max(detail::units_of(range));
+}
+
+// std::reduce over the units of `range`, `op` has to be associative and commutative
+template<typename _Range, typename _T, typename _BinaryOp, class = detail::enable_if_unit_range_t<_Range>>
+_T reduce(const _Range &range, _T init, _BinaryOp op)
+{
+    const auto in = detail::units_of(range);
+    return std::reduce(in.begin(), in.end(), std::move(init), std::move(op));
+}
+
+#if SI_HAS_EXECUTION
+template<typename _Policy, typename _Range,
+         class = detail::enable_if_execution_policy_t<_Policy>, class = detail::enable_if_unit_range_t<_Range>>
+auto sum(_Policy &&policy, const _Range &range)
+{
+    return detail::sum(detail::units_of(range), std::forward<_Policy>(policy));
+}
+
+template<typename _Policy, typename _Range,
+         class = detail::enable_if_execution_policy_t<_Policy>, class = detail::enable_if_unit_range_t<_Range>>
+auto mean(_Policy &&policy, const _Range &range)
+{
+    return detail::mean(detail::units_of(range), std::forward<_Policy>(policy));
+}
+
+template<typename _Policy, typename _Range1, typename _Range2,
+         class = detail::enable_if_execution_policy_t<_Policy>,
+         class = detail::enable_if_unit_range_t<_Range1>, class = detail::enable_if_unit_range_t<_Range2>>
+auto dot(_Policy &&policy, const _Range1 &lhs, const _Range2 &rhs)
+{
+    return detail::dot(detail::units_of(lhs), detail::units_of(rhs), std::forward<_Policy>(policy));
+}
+
+template<typename _Policy, typename _Range,
+         class = detail::enable_if_execution_policy_t<_Policy>, class = detail::enable_if_unit_range_t<_Range>>
+auto min_max(_Policy &&policy, const _Range &range)
+{
+    return detail::min_max(detail::units_of(range), std::forward<_Policy>(policy));
+}
+
+template<typename _Policy, typename _Range, typename _T, typename _BinaryOp,
+         class = detail::enable_if_execution_policy_t<_Policy>, class = detail::enable_if_unit_range_t<_Range>>
+_T reduce(_Policy &&policy, const _Range &range, _T init, _BinaryOp op)
+{
+    const auto in = detail::units_of(range);
+    return std::reduce(std::forward<_Policy>(policy), in.begin(), in.end(), std::move(init), std::move(op));
+}
+#endif
+} // namespace si
@@ -0,0 +1,238 @@
+#pragma once
+
+#include "si/core.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ratio>
+#include <type_traits>
+
+// Downsampling of timestamped samples into buckets of a fixed width.
+//
+// Samples are pushed one by one with their timestamp, and every bucket is handed to a
+// sink once no sample can fall into it any more: the number of samples, their mean,
+// minimum, maximum and last value, and the integral of the value over time. Buckets are
+// aligned on multiples of their width since the epoch of the timestamps.
+//
+// Samples may arrive out of order by up to a tolerance given at construction. Buckets
+// stay open until the newest timestamp is that far past their end, samples older than
+// that are dropped and counted. The open buckets live in a ring allocated once, so that
+// a sample costs a constant amount of work and no allocation, plus a constant amount
+// for every bucket it closes.
+//
+// The integral holds every value until the next sample, in the order of the timestamps.
+// Samples arriving out of order count in every other statistic of their bucket but not
+// in the integral, which would need the samples around them. A gap with no samples is
+// emitted as buckets with a count of 0 and only their integral set.
+//
+//     si::resampler<si::pressure<float>> resampler{si::millisecond{250}, si::millisecond{20}};
+//     resampler.push(timestamp, value, [&](const auto &bucket) { out.push_back(bucket); });
+namespace si
+{
+template<typename _Unit>
+struct bucket
+{
+    using timestamp     = unit<std::int64_t, std::nano, detail::_s<1>>;
+    using mean_type     = detail::real_unit_t<_Unit>;
+    using integral_type = integral_t<_Unit>;
+
+    timestamp start;        // the bucket covers [start, start + width)
+    std::size_t count = 0;  // samples in the bucket, 0 for a gap
+    mean_type mean;
+    _Unit min;
+    _Unit max;
+    _Unit last;             // the value of the sample with the latest timestamp
+    integral_type integral; // of the value held from sample to sample
+};
+
+template<typename _Unit>
+class resampler
+{
+public:
+    using value_type  = _Unit;
+    using timestamp   = unit<std::int64_t, std::nano, detail::_s<1>>;
+    using bucket_type = bucket<_Unit>;
+
+    static_assert(detail::is_unit<_Unit>::value, "only units can be resampled");
+
+    // buckets of `width`, accepting samples up to `tolerance` older than the newest one
+    template<typename _Rep1, typename _Ratio1, typename _Rep2 = std::int64_t, typename _Ratio2 = std::nano>
+    explicit resampler(const unit<_Rep1, _Ratio1, detail::_s<1>> &width,
+                       const unit<_Rep2, _Ratio2, detail::_s<1>> &tolerance = unit<_Rep2, _Ratio2, detail::_s<1>>{})
+        : _width(unit_cast<timestamp>(width).count()), _tolerance(unit_cast<timestamp>(tolerance).count())
+    {
+        assert(_width > 0 && _tolerance >= 0);
+        // every bucket from the one the tolerance reaches back to up to the newest one
+        _slots = static_cast<std::size_t>(_tolerance / _width) + 2;
+        _ring.reset(new slot[_slots]);
+    }
+
+    timestamp width() const noexcept { return timestamp{_width}; }
+    timestamp tolerance() const noexcept { return timestamp{_tolerance}; }
+
+    // samples dropped for arriving after their bucket was emitted
+    std::size_t dropped() const noexcept { return _dropped; }
+
+    // adds a sample, handing every bucket it closes to `sink`, oldest first
+    template<typename _Sink>
+    void push(timestamp t, const _Unit &value, _Sink &&sink)
+    {
+        const auto time = t.count();
+        if (!_started) start(time);
+
+        if (time >= _newest) {
+            advance(time, sink);
+            _held = value;
+        } else if (bucket_of(time) < _next) {
+            ++_dropped;
+            return;
+        }
+        add(time, value);
+    }
+
+    // emits every open bucket, the integral of the last one stops at the newest sample,
+    // and starts over
+    template<typename _Sink>
+    void flush(_Sink &&sink)
+    {
+        if (!_started) return;
+        close(_current + 1, sink);
+        _started = false;
+    }
+
+private:
+    using real_unit     = detail::real_unit_t<_Unit>;
+    using integral_type = integral_t<_Unit>;
+
+    struct slot
+    {
+        std::int64_t index = 0;
+        bool touched = false;
+        std::size_t count = 0;
+        real_unit sum;
+        _Unit min;
+        _Unit max;
+        _Unit last;
+        std::int64_t last_time = 0;
+        integral_type integral;
+    };
+
+    // floor(t / width), the buckets before the epoch included
+    std::int64_t bucket_of(std::int64_t t) const noexcept
+    {
+        const auto q = t / _width;
+        return q - (t % _width < 0);
+    }
+
+    void start(std::int64_t time) noexcept
+    {
+        _started = true;
+        _newest = time;
+        _next = bucket_of(time - _tolerance);
+        _close_at = (_next + 1) * _width + _tolerance;
+        for (std::size_t i = 0; i < _slots; ++i) _ring[i].touched = false;
+        _current = bucket_of(time);
+        _current_end = (_current + 1) * _width;
+        _current_slot = &open(_current);
+    }
+
+    // the slot of bucket k, which is reset on first use
+    slot &open(std::int64_t k) noexcept
+    {
+        auto &s = _ring[index_of(k)];
+        if (!s.touched || s.index != k) {
+            s = slot{};
+            s.index = k;
+            s.touched = true;
+        }
+        return s;
+    }
+
+    // the open buckets are consecutive and never more than the slots
+    std::size_t index_of(std::int64_t k) const noexcept
+    {
+        const auto n = static_cast<std::int64_t>(_slots);
+        return static_cast<std::size_t>(((k % n) + n) % n);
+    }
+
+    void add(std::int64_t time, const _Unit &value)
+    {
+        // samples in order always fall in the bucket of the newest one
+        auto &s = time >= _current_end - _width ? *_current_slot : open(bucket_of(time));
+        if (s.count == 0) {
+            s.min = s.max = s.last = value;
+            s.last_time = time;
+        } else {
+            if (value < s.min) s.min = value;
+            if (s.max < value) s.max = value;
+            if (time >= s.last_time) {
+                s.last = value;
+                s.last_time = time;
+            }
+        }
+        ++s.count;
+        s.sum += real_unit{value};
+    }
+
+    // Moves the newest timestamp up to `time`, the value held since the previous sample
+    // filling the buckets in between, and emits every bucket the tolerance has passed.
+    template<typename _Sink>
+    void advance(std::int64_t time, _Sink &sink)
+    {
+        while (_newest < time) {
+            const auto end = std::min(time, _current_end);
+            const auto held_for = static_cast<typename real_unit::rep>(end - _newest) * typename real_unit::rep{1e-9};
+            _current_slot->integral += integral_type{real_unit{_held}.count() * held_for};
+            _newest = end;
+            if (_newest >= _close_at) close(bucket_of(_newest - _tolerance), sink);
+            if (_newest == _current_end) {
+                ++_current;
+                _current_end += _width;
+                _current_slot = &open(_current);
+            }
+        }
+    }
+
+    // emits the buckets before `k`
+    template<typename _Sink>
+    void close(std::int64_t k, _Sink &sink)
+    {
+        for (; _next < k; ++_next) {
+            auto &s = _ring[index_of(_next)];
+            if (!s.touched || s.index != _next) continue;
+
+            bucket_type b;
+            b.start = timestamp{_next * _width};
+            b.count = s.count;
+            if (s.count > 0) {
+                b.mean = s.sum / static_cast<typename real_unit::rep>(s.count);
+                b.min = s.min;
+                b.max = s.max;
+                b.last = s.last;
+            }
+            b.integral = s.integral;
+            s.touched = false;
+            sink(static_cast<const bucket_type &>(b));
+        }
+        _close_at = (_next + 1) * _width + _tolerance;
+    }
+
+    std::int64_t _width;
+    std::int64_t _tolerance;
+    std::size_t _slots = 0;
+    std::unique_ptr<slot[]> _ring;
+
+    bool _started = false;
+    std::int64_t _newest = 0; // the latest timestamp, up to which the held value is integrated
+    std::int64_t _next = 0;   // the oldest bucket not emitted yet
+    std::int64_t _close_at = 0; // the newest timestamp from which the oldest bucket is emitted
+    std::int64_t _current = 0;  // the bucket of the newest timestamp
+    std::int64_t _current_end = 0;
+    slot *_current_slot = nullptr;
+    _Unit _held;
+    std::size_t _dropped = 0;
+};
+} // namespace si
@@ -0,0 +1,36 @@
+// The named module si: si::unit, unit_cast, the operators, the std::common_type
+// specialisations, the named units of si/units.hpp and the conversions of
+// si/chrono.hpp, parsed once instead of in every translation unit.
+//
+//     #include <ratio>
+//     import si;
+//
+//     si::length<double, std::kilo> d{1.5};
+//
+// The module exports declarations only: the UNIT_TEMPLATE and PREFIXES macros, and
+// std names such as std::kilo, are not visible to importers, who include the
+// standard headers they name themselves (before the import, with GCC).
+// si/io.hpp and si/charconv.hpp are left out, formatting through the module does
+// not link with GCC 12; include them instead where units are written or parsed.
+//
+// Built by CMake with -DBUILD_MODULE=ON, or by hand with
+//     g++ -std=c++20 -fmodules-ts -Iinclude -x c++ -c include/si/si.cppm
+module;
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <ratio>
+#include <type_traits>
+#include <utility>
+
+export module si;
+
+export extern "C++" {
+#include "si/core.hpp"
+#include "si/units.hpp"
+#include "si/chrono.hpp"
+}
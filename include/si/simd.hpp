@@ -0,0 +1,119 @@
+#pragma once
+
+#include "si/core.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+#if __has_include(<experimental/simd>)
+#include <experimental/simd>
+#endif
+
+#if defined(__cpp_lib_experimental_parallel_simd)
+#define SI_HAS_SIMD 1
+#else
+#define SI_HAS_SIMD 0
+#endif
+
+// Units of std::experimental::simd packs, for kernels that work on several values at
+// once: the operators check the dimensions once for every lane, and comparisons return
+// the simd_mask of the lanes for which they hold.
+//
+// unit_cast scales every lane as it would a single count, a scalar unit converts to a
+// unit of packs by broadcasting it. Packs of integers are scaled in vectors for ratios
+// whose numerator or denominator is 1, other ratios go through the scalar conversion
+// lane by lane. Packs only convert to packs of the same element type, whose common
+// type std::common_type knows, and the saturate and checked unit_casts are for scalar
+// representations only.
+//
+//     using pack = std::experimental::native_simd<double>;
+//     const si::velocity<pack> v = si::load_pack<pack>(distances) / si::load_pack<pack>(times);
+//     auto counts = v.count();
+//     std::experimental::where(v > limit, counts) = limit.count();
+//
+// Prefer where to std::experimental::min and max with GCC 12, whose optimize attribute
+// keeps the operators of the calling function from being inlined.
+#if SI_HAS_SIMD
+namespace si
+{
+template<typename _T, typename _Abi>
+struct treat_as_floating_point<std::experimental::simd<_T, _Abi>> : treat_as_floating_point<_T> {};
+
+namespace detail
+{
+template<typename _T, typename _Abi>
+struct is_pack<std::experimental::simd<_T, _Abi>> : std::true_type {};
+
+// the element type of a pack, the type itself for a scalar
+template<typename _T, typename = void>
+struct lane
+{
+    using type = _T;
+};
+
+template<typename _T>
+struct lane<_T, std::enable_if_t<is_pack_v<_T>>>
+{
+    using type = typename _T::value_type;
+};
+
+template<typename _T>
+using lane_t = typename lane<_T>::type;
+
+template<typename _ToRep, typename _CommonRep, typename _Ratio, typename _Rep>
+_ToRep convert_pack(const _Rep &count)
+{
+    static_assert(is_pack_v<_ToRep>, "a unit of packs does not convert to a unit of a single count");
+    namespace stdx = std::experimental;
+
+    using to          = lane_t<_ToRep>;
+    using common      = lane_t<_CommonRep>;
+    using common_pack = stdx::rebind_simd_t<common, _ToRep>;
+    constexpr auto num = _Ratio::num;
+    constexpr auto den = _Ratio::den;
+
+    // a scalar is broadcast first
+    const auto pack = [&] {
+        if constexpr (is_pack_v<_Rep>) {
+            return stdx::static_simd_cast<common_pack>(count);
+        } else {
+            return common_pack(static_cast<common>(count));
+        }
+    }();
+
+    if constexpr (num == 1 && den == 1) {
+        return stdx::static_simd_cast<_ToRep>(pack);
+    } else if constexpr (treat_as_floating_point_v<common>) {
+        using real = arithmetic_t<common>;
+        constexpr auto factor = static_cast<real>(num) / static_cast<real>(den);
+        return stdx::static_simd_cast<_ToRep>(stdx::static_simd_cast<stdx::rebind_simd_t<real, _ToRep>>(pack) * factor);
+    } else if constexpr (den == 1 && fits<common>(num)) {
+        return stdx::static_simd_cast<_ToRep>(pack * static_cast<common>(num));
+    } else if constexpr (num == 1 && fits<common>(den)) {
+        return stdx::static_simd_cast<_ToRep>(pack / static_cast<common>(den));
+    } else {
+        return _ToRep([&](auto i) { return convert_count<to, common, _Ratio>(pack[i]); });
+    }
+}
+} // namespace detail
+
+// the first _Pack::size() units at `units`, as a unit of a pack
+template<typename _Pack, typename _Rep, typename _Ratio, typename _Base,
+         class = std::enable_if_t<std::is_same<typename _Pack::value_type, _Rep>::value>>
+unit<_Pack, _Ratio, _Base> load_pack(const unit<_Rep, _Ratio, _Base> *units)
+{
+    _Pack counts;
+    counts.copy_from(reinterpret_cast<const _Rep *>(units), std::experimental::element_aligned);
+    return unit<_Pack, _Ratio, _Base>{counts};
+}
+
+// writes the lanes of `u`, converted to the ratio of the units at `units`
+template<typename _Pack, typename _Ratio2, typename _Rep, typename _Ratio, typename _Base,
+         class = std::enable_if_t<std::is_same<typename _Pack::value_type, _Rep>::value>>
+void store_pack(const unit<_Pack, _Ratio2, _Base> &u, unit<_Rep, _Ratio, _Base> *units)
+{
+    const auto counts = unit_cast<unit<_Pack, _Ratio, _Base>>(u).count();
+    counts.copy_to(reinterpret_cast<_Rep *>(units), std::experimental::element_aligned);
+}
+} // namespace si
+#endif
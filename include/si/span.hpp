@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace si
+{
+// A non-owning view over a contiguous sequence of objects, a stand-in for
+// C++20's std::span with a dynamic extent.
+template<typename _T>
+class span
+{
+public:
+    using element_type = _T;
+    using value_type   = std::remove_cv_t<_T>;
+    using size_type    = std::size_t;
+    using pointer      = _T *;
+    using reference    = _T &;
+    using iterator     = _T *;
+
+    constexpr span() noexcept = default;
+    constexpr span(pointer data, size_type size) noexcept
+        : _data(data), _size(size) { }
+
+    template<std::size_t _N>
+    constexpr span(element_type (&array)[_N]) noexcept
+        : _data(array), _size(_N) { }
+
+    // any contiguous container exposing data() and size(), e.g. std::vector or std::array
+    template<typename _Container,
+             class = std::enable_if_t<!std::is_same<std::decay_t<_Container>, span>::value>,
+             class = std::enable_if_t<std::is_convertible<
+                 std::remove_pointer_t<decltype(std::declval<_Container &>().data())> (*)[],
+                 element_type (*)[]>::value>>
+    constexpr span(_Container &&container) noexcept
+        : _data(container.data()), _size(container.size()) { }
+
+    template<typename _U,
+             class = std::enable_if_t<std::is_convertible<_U (*)[], element_type (*)[]>::value>>
+    constexpr span(const span<_U> &other) noexcept
+        : _data(other.data()), _size(other.size()) { }
+
+    constexpr pointer data() const noexcept { return _data; }
+    constexpr size_type size() const noexcept { return _size; }
+    constexpr size_type size_bytes() const noexcept { return _size * sizeof(element_type); }
+    constexpr bool empty() const noexcept { return _size == 0; }
+
+    constexpr reference operator[](size_type i) const
+    {
+        assert(i < _size);
+        return _data[i];
+    }
+
+    constexpr iterator begin() const noexcept { return _data; }
+    constexpr iterator end() const noexcept { return _data + _size; }
+
+    constexpr span first(size_type count) const
+    {
+        assert(count <= _size);
+        return {_data, count};
+    }
+
+    constexpr span subspan(size_type offset, size_type count) const
+    {
+        assert(offset + count <= _size);
+        return {_data + offset, count};
+    }
+
+private:
+    pointer _data = nullptr;
+    size_type _size = 0;
+};
+
+namespace detail
+{
+// the same elements viewed as another type that holds the same single value, such
+// as a std::chrono::duration and the si::time of its representation and ratio
+template<typename _To, typename _From>
+span<_To> reinterpret_span(span<_From> elements) noexcept
+{
+    static_assert(sizeof(_From) == sizeof(_To) && alignof(_From) == alignof(_To)
+                      && std::is_standard_layout<_From>::value && std::is_standard_layout<_To>::value,
+                  "the elements cannot be viewed as one another");
+    return {reinterpret_cast<_To *>(elements.data()), elements.size()};
+}
+} // namespace detail
+} // namespace si
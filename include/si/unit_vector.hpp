@@ -0,0 +1,224 @@
+#pragma once
+
+#include "si/convert.hpp"
+#include "si/core.hpp"
+#include "si/span.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace si
+{
+// A contiguous, growable array of units of a single type.
+//
+// The units are laid out exactly like an array of their representation, so the
+// storage can be handed to numeric code as a plain `rep *` through data(), and
+// read back as units through begin()/end() or operator[].
+//
+// unit_vector is move-only, copies have to be asked for with clone(). Since the
+// elements are trivially copyable the buffer is grown with realloc, which can
+// often extend the allocation in place instead of allocating and copying.
+template<typename _Unit>
+class unit_vector
+{
+public:
+    using value_type      = _Unit;
+    using rep             = typename _Unit::rep;
+    using size_type       = std::size_t;
+    using reference       = _Unit &;
+    using const_reference = const _Unit &;
+    using iterator        = _Unit *;
+    using const_iterator  = const _Unit *;
+
+    static_assert(sizeof(_Unit) == sizeof(rep),
+                  "a unit must have the same size as its representation");
+    static_assert(alignof(_Unit) == alignof(rep),
+                  "a unit must have the same alignment as its representation");
+    static_assert(std::is_trivially_copyable<_Unit>::value,
+                  "a unit must be trivially copyable");
+    static_assert(std::is_standard_layout<_Unit>::value,
+                  "a unit must be standard layout for its storage to be viewed as rep");
+
+    unit_vector() noexcept = default;
+
+    explicit unit_vector(size_type size) { resize(size); }
+
+    unit_vector(size_type size, const _Unit &value)
+    {
+        reserve(size);
+        std::fill_n(_data, size, value);
+        _size = size;
+    }
+
+    unit_vector(std::initializer_list<_Unit> values)
+        : unit_vector(span<const _Unit>{values.begin(), values.size()}) { }
+
+    explicit unit_vector(span<const _Unit> values)
+    {
+        reserve(values.size());
+        if (!values.empty()) {
+            std::memcpy(_data, values.data(), values.size_bytes());
+        }
+        _size = values.size();
+    }
+
+    unit_vector(const unit_vector &) = delete;
+    unit_vector &operator=(const unit_vector &) = delete;
+
+    unit_vector(unit_vector &&other) noexcept
+        : _data(std::exchange(other._data, nullptr)),
+          _size(std::exchange(other._size, 0)),
+          _capacity(std::exchange(other._capacity, 0)) { }
+
+    unit_vector &operator=(unit_vector &&other) noexcept
+    {
+        if (this != &other) {
+            std::free(_data);
+            _data     = std::exchange(other._data, nullptr);
+            _size     = std::exchange(other._size, 0);
+            _capacity = std::exchange(other._capacity, 0);
+        }
+        return *this;
+    }
+
+    ~unit_vector() { std::free(_data); }
+
+    // an explicit, exactly sized copy
+    unit_vector clone() const { return unit_vector{span<const _Unit>{*this}}; }
+
+    // raw access to the representation, for vectorized kernels and numeric libraries
+    rep *data() noexcept { return reinterpret_cast<rep *>(_data); }
+    const rep *data() const noexcept { return reinterpret_cast<const rep *>(_data); }
+
+    size_type size() const noexcept { return _size; }
+    size_type capacity() const noexcept { return _capacity; }
+    size_type max_size() const noexcept { return std::numeric_limits<std::ptrdiff_t>::max() / sizeof(_Unit); }
+    bool empty() const noexcept { return _size == 0; }
+
+    reference operator[](size_type i)
+    {
+        assert(i < _size);
+        return _data[i];
+    }
+
+    const_reference operator[](size_type i) const
+    {
+        assert(i < _size);
+        return _data[i];
+    }
+
+    reference front() { return (*this)[0]; }
+    const_reference front() const { return (*this)[0]; }
+    reference back() { return (*this)[_size - 1]; }
+    const_reference back() const { return (*this)[_size - 1]; }
+
+    iterator begin() noexcept { return _data; }
+    iterator end() noexcept { return _data + _size; }
+    const_iterator begin() const noexcept { return _data; }
+    const_iterator end() const noexcept { return _data + _size; }
+
+    operator span<_Unit>() noexcept { return {_data, _size}; }
+    operator span<const _Unit>() const noexcept { return {_data, _size}; }
+
+    void reserve(size_type capacity)
+    {
+        if (capacity > _capacity) reallocate(capacity);
+    }
+
+    void shrink_to_fit()
+    {
+        if (_size == 0) {
+            std::free(std::exchange(_data, nullptr));
+            _capacity = 0;
+        } else if (_size < _capacity) {
+            reallocate(_size);
+        }
+    }
+
+    // new elements are zero
+    void resize(size_type size)
+    {
+        reserve(size);
+        std::fill(_data + std::min(size, _size), _data + size, _Unit{});
+        _size = size;
+    }
+
+    // like resize, but leaves the new elements uninitialized, for when they are about
+    // to be overwritten anyway
+    void resize_for_overwrite(size_type size)
+    {
+        reserve(size);
+        _size = size;
+    }
+
+    void clear() noexcept { _size = 0; }
+
+    void push_back(const _Unit &value)
+    {
+        if (_size == _capacity) grow(_size + 1);
+        _data[_size++] = value;
+    }
+
+    void emplace_back(rep count) { push_back(_Unit{count}); }
+
+    void pop_back()
+    {
+        assert(_size > 0);
+        --_size;
+    }
+
+    // appends all of values with at most one reallocation
+    void append(span<const _Unit> values)
+    {
+        if (values.empty()) return;
+        if (_size + values.size() > _capacity) grow(_size + values.size());
+        std::memcpy(_data + _size, values.data(), values.size_bytes());
+        _size += values.size();
+    }
+
+private:
+    // grows by half, up to max_size()
+    void grow(size_type min_capacity)
+    {
+        const auto grown = _capacity + std::min(_capacity / 2, max_size() - _capacity);
+        reallocate(std::max({min_capacity, grown, min_growth()}));
+    }
+
+    // the smallest allocation worth making, one cache line
+    static constexpr size_type min_growth() { return std::max<size_type>(1, 64 / sizeof(_Unit)); }
+
+    void reallocate(size_type capacity)
+    {
+        if (capacity > max_size()) throw std::length_error{"si::unit_vector is too long"};
+        auto *data = static_cast<_Unit *>(std::realloc(_data, capacity * sizeof(_Unit)));
+        if (data == nullptr) throw std::bad_alloc{};
+        _data     = data;
+        _capacity = capacity;
+    }
+
+    _Unit *_data        = nullptr;
+    size_type _size     = 0;
+    size_type _capacity = 0;
+};
+
+// converts all the units of a unit_vector at once, see si::convert
+template<typename _ToUnit, typename _Unit>
+auto unit_cast(const unit_vector<_Unit> &units)
+    -> std::enable_if_t<std::is_same<typename _ToUnit::base, typename _Unit::base>::value,
+                        unit_vector<_ToUnit>>
+{
+    unit_vector<_ToUnit> result;
+    result.resize_for_overwrite(units.size());
+    convert(span<const _Unit>{units}, span<_ToUnit>{result});
+    return result;
+}
+} // namespace si
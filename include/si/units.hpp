@@ -0,0 +1,82 @@
+#pragma once
+
+#include "si/core.hpp"
+
+#include <ratio>
+
+namespace si
+{
+#define UNIT_TEMPLATE template<typename _Rep, typename _Ratio = std::ratio<1>>
+// base units (base unit for mass is kg, not gram)
+template<typename _Rep, typename _Ratio = std::ratio<1000, 1>>
+using mass = unit<_Rep, _Ratio, detail::_g<1>>;
+UNIT_TEMPLATE using length             = unit<_Rep, _Ratio, detail::_m<1>>;
+UNIT_TEMPLATE using time               = unit<_Rep, _Ratio, detail::_s<1>>;
+UNIT_TEMPLATE using current            = unit<_Rep, _Ratio, detail::_A<1>>;
+UNIT_TEMPLATE using temperature        = unit<_Rep, _Ratio, detail::_K<1>>;
+UNIT_TEMPLATE using amount             = unit<_Rep, _Ratio, detail::_mol<1>>;
+UNIT_TEMPLATE using luminous_intensity = unit<_Rep, _Ratio, detail::_cd<1>>;
+// derived units
+UNIT_TEMPLATE using area                   = unit<_Rep, _Ratio, detail::_m<2>>;
+UNIT_TEMPLATE using volume                 = unit<_Rep, _Ratio, detail::_m<3>>;
+UNIT_TEMPLATE using velocity               = decltype(length<_Rep, _Ratio>{} / time<_Rep, _Ratio>{});
+UNIT_TEMPLATE using acceleration           = decltype(velocity<_Rep, _Ratio>{} / time<_Rep, _Ratio>{});
+UNIT_TEMPLATE using angle                  = unit<_Rep, _Ratio, detail::base<>>;
+UNIT_TEMPLATE using solid_angle            = unit<_Rep, _Ratio, detail::base<>>;
+UNIT_TEMPLATE using frequency              = decltype(1 / time<_Rep, _Ratio>{});
+UNIT_TEMPLATE using force                  = unit<_Rep, _Ratio, detail::base<1, 1, -2>>;
+UNIT_TEMPLATE using pressure               = decltype(force<_Rep, _Ratio>{} / area<_Rep, _Ratio>{});
+UNIT_TEMPLATE using energy                 = decltype(force<_Rep, _Ratio>{} * length<_Rep, _Ratio>{});
+UNIT_TEMPLATE using power                  = decltype(energy<_Rep, _Ratio>{} / time<_Rep, _Ratio>{});
+UNIT_TEMPLATE using electric_charge        = decltype(time<_Rep, _Ratio>{} * current<_Rep, _Ratio>{});
+UNIT_TEMPLATE using voltage                = decltype(power<_Rep, _Ratio>{} / current<_Rep, _Ratio>{});
+UNIT_TEMPLATE using capacitance            = decltype(electric_charge<_Rep, _Ratio>{} / voltage<_Rep, _Ratio>{});
+UNIT_TEMPLATE using electric_resistance    = decltype(voltage<_Rep, _Ratio>{} / current<_Rep, _Ratio>{});
+UNIT_TEMPLATE using electrical_conductance = decltype(current<_Rep, _Ratio>{} / voltage<_Rep, _Ratio>{});
+UNIT_TEMPLATE using magnetic_flux          = decltype(voltage<_Rep, _Ratio>{} * time<_Rep, _Ratio>{});
+UNIT_TEMPLATE using magnetic_flux_density  = decltype(magnetic_flux<_Rep, _Ratio>{} / area<_Rep, _Ratio>{});
+UNIT_TEMPLATE using inductance             = decltype(magnetic_flux<_Rep, _Ratio>{} / current<_Rep, _Ratio>{});
+UNIT_TEMPLATE using luminous_flux          = decltype(luminous_intensity<_Rep, _Ratio>{} * solid_angle<_Rep, _Ratio>{});
+UNIT_TEMPLATE using illuminance            = decltype(luminous_flux<_Rep, _Ratio>{} / area<_Rep, _Ratio>{});
+UNIT_TEMPLATE using radioactivity          = unit<_Rep, _Ratio, detail::_s<-1>>;
+UNIT_TEMPLATE using absorbed_dose          = decltype(energy<_Rep, _Ratio>{} / mass<_Rep, _Ratio>{});
+UNIT_TEMPLATE using equivalent_dose        = decltype(energy<_Rep, _Ratio>{} / mass<_Rep, _Ratio>{});
+UNIT_TEMPLATE using catalytic_activity     = decltype(amount<_Rep, _Ratio>{} / time<_Rep, _Ratio>{});
+#undef UNIT_TEMPLATE
+
+#define PREFIXES(unit, dim)         \
+    PREFIXED_UNIT(atto,  unit, dim) \
+    PREFIXED_UNIT(atto,  unit, dim) \
+    PREFIXED_UNIT(femto, unit, dim) \
+    PREFIXED_UNIT(pico,  unit, dim) \
+    PREFIXED_UNIT(nano,  unit, dim) \
+    PREFIXED_UNIT(micro, unit, dim) \
+    PREFIXED_UNIT(milli, unit, dim) \
+    PREFIXED_UNIT(centi, unit, dim) \
+    PREFIXED_UNIT(deci,  unit, dim) \
+    using unit = dim<int, std::ratio<1>>; \
+    PREFIXED_UNIT(deca,  unit, dim) \
+    PREFIXED_UNIT(hecto, unit, dim) \
+    PREFIXED_UNIT(kilo,  unit, dim) \
+    PREFIXED_UNIT(mega,  unit, dim) \
+    PREFIXED_UNIT(giga,  unit, dim) \
+    PREFIXED_UNIT(tera,  unit, dim) \
+    PREFIXED_UNIT(peta,  unit, dim) \
+    PREFIXED_UNIT(exa,   unit, dim)
+
+#define PREFIXED_UNIT(prefix, unit, dim) using prefix ## unit = dim<int, std::prefix>;
+
+PREFIXES(meter, length)
+PREFIXES(gram, mass)
+PREFIXES(second, time)
+PREFIXES(ampere, current)
+PREFIXES(kelvin, temperature)
+PREFIXES(mole, amount)
+PREFIXES(candela, luminous_intensity)
+#undef PREFIXES
+#undef PREFIXED_UNIT
+} // namespace si
+
+#if defined(SI_COMPILED)
+#include "si/extern.hpp"
+#endif
@@ -0,0 +1,6 @@
+// The explicit instantiations of SI::SI_compiled, declared extern by si/extern.hpp.
+#include "si/extern.hpp"
+
+#define SI_INSTANTIATE_UNIT(...) template struct __VA_ARGS__;
+SI_FOR_EACH_COMPILED_UNIT(SI_INSTANTIATE_UNIT)
+#undef SI_INSTANTIATE_UNIT
@@ -0,0 +1,102 @@
+#include <catch.hpp>
+
+#include "si/atomic.hpp"
+#include "si/units.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+template<typename _Fn>
+void run_threads(std::size_t count, _Fn fn)
+{
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < count; ++i) threads.emplace_back(fn);
+    for (auto &t : threads) t.join();
+}
+
+template<typename _T, typename _Rep2, typename _Ratio2, typename _Base2, typename = void>
+struct can_add : std::false_type {};
+
+template<typename _T, typename _Rep2, typename _Ratio2, typename _Base2>
+struct can_add<_T, _Rep2, _Ratio2, _Base2,
+               std::void_t<decltype(std::declval<_T &>().fetch_add(si::unit<_Rep2, _Ratio2, _Base2>{}))>>
+    : std::true_type {};
+} // namespace
+
+TEST_CASE("Atomic units", "[atomic]")
+{
+    SECTION("Loads, stores and exchanges")
+    {
+        si::atomic_unit<si::length<int, std::milli>> a{si::length<int, std::milli>{5}};
+        CHECK(a.load() == si::length<int, std::milli>{5});
+        a.store(si::length<int, std::milli>{7});
+        CHECK(a.exchange(si::length<int, std::milli>{9}).count() == 7);
+
+        auto expected = si::length<int, std::milli>{8};
+        CHECK_FALSE(a.compare_exchange_strong(expected, si::length<int, std::milli>{10}));
+        CHECK(expected.count() == 9);
+        CHECK(a.compare_exchange_strong(expected, si::length<int, std::milli>{10}));
+        CHECK(static_cast<si::length<int, std::milli>>(a).count() == 10);
+        static_assert(si::atomic_unit<si::length<int>>::is_always_lock_free, "");
+    }
+
+    SECTION("Other ratios are converted once")
+    {
+        si::atomic_unit<si::energy<double>> consumed;
+        CHECK(consumed.fetch_add(si::energy<double, std::kilo>{1.5}).count() == 0.0);
+        CHECK(consumed.fetch_sub(si::energy<int>{500}).count() == 1500.0);
+        CHECK((consumed += si::energy<int, std::milli>{250}).count() == 1000.25);
+        CHECK((consumed -= si::energy<double>{0.25}).count() == 1000.0);
+
+        si::atomic_unit<si::length<std::int64_t, std::milli>> travelled;
+        travelled.fetch_add(si::length<int>{2});
+        CHECK(travelled.load().count() == 2000);
+
+        // as for si::unit, nothing that would truncate a fraction is added implicitly
+        using lengths = si::atomic_unit<si::length<int>>;
+        static_assert(can_add<lengths, int, std::kilo, si::length<int>::base>::value, "");
+        static_assert(!can_add<lengths, double, std::ratio<1>, si::length<int>::base>::value, "");
+        static_assert(!can_add<lengths, int, std::ratio<1>, si::time<int>::base>::value, "");
+    }
+
+    SECTION("Concurrent additions are not lost")
+    {
+        constexpr std::size_t threads = 4;
+        constexpr int additions = 10000;
+        si::atomic_unit<si::mass<std::int64_t, std::ratio<1>>> grams;
+        si::atomic_unit<si::time<double>> elapsed;
+        run_threads(threads, [&] {
+            for (int i = 0; i < additions; ++i) {
+                grams.fetch_add(si::mass<int>{3});
+                elapsed.fetch_add(si::time<double, std::milli>{500});
+            }
+        });
+        CHECK(grams.load().count() == 3000 * threads * additions);
+        CHECK(elapsed.load().count() == 0.5 * threads * additions);
+    }
+}
+
+TEST_CASE("Sharded atomic units", "[atomic]")
+{
+    si::sharded_atomic_unit<si::energy<double>> consumed{3};
+    CHECK(consumed.shards() == 4);
+    CHECK(si::sharded_atomic_unit<si::energy<double>>{}.shards() >= 1);
+
+    constexpr std::size_t threads = 6;
+    constexpr int additions = 10000;
+    run_threads(threads, [&] {
+        for (int i = 0; i < additions; ++i) {
+            consumed.add(si::energy<double, std::kilo>{0.002});
+            consumed -= si::energy<int>{1};
+        }
+    });
+    CHECK(consumed.load().count() == Approx(1.0 * threads * additions));
+
+    consumed.reset();
+    consumed += si::energy<int>{3};
+    CHECK(static_cast<si::energy<double>>(consumed).count() == 3.0);
+}
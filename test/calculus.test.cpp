@@ -0,0 +1,140 @@
+#include <catch.hpp>
+
+#include "si/calculus.hpp"
+#include "si/units.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <list>
+#include <type_traits>
+#include <vector>
+
+static_assert(std::is_same<si::integral_t<si::power<double>>, si::energy<double>>::value, "");
+static_assert(std::is_same<si::integral_t<si::power<float, std::kilo>>, si::energy<float, std::kilo>>::value, "");
+static_assert(std::is_same<si::integral_t<si::power<int>>, si::energy<double>>::value, "");
+static_assert(std::is_same<si::derivative_t<si::length<double>>, si::velocity<double>>::value, "");
+static_assert(std::is_same<si::derivative_t<si::velocity<float>>, si::acceleration<float>>::value, "");
+
+namespace
+{
+template<typename _Range, typename = void>
+struct integrable : std::false_type {};
+
+template<typename _Range>
+struct integrable<_Range, std::void_t<decltype(std::declval<si::uniform_integrator<si::power<double>> &>().push(
+                              std::declval<const _Range &>()))>> : std::true_type {};
+} // namespace
+
+// only ranges in contiguous storage are pushed by chunks
+static_assert(integrable<std::vector<si::power<double>>>::value, "");
+static_assert(!integrable<std::list<si::power<double>>>::value, "");
+
+TEST_CASE("Timestamped samples are integrated with the trapezoid rule", "[calculus]")
+{
+    using nanoseconds = si::time<std::int64_t, std::nano>;
+    si::integrator<si::power<double>, nanoseconds> meter;
+    CHECK(meter.total().count() == 0);
+
+    meter.push(nanoseconds{0}, si::power<double>{100});
+    meter.push(nanoseconds{2000000000}, si::power<double>{300});
+    meter.push(nanoseconds{2500000000}, si::power<double>{300});
+    const si::energy<double> consumed = meter.total();
+    CHECK(consumed.count() == Approx(400 + 150));
+
+    meter.reset();
+    CHECK(meter.total().count() == 0);
+    meter.push(nanoseconds{5}, si::power<double>{1});
+    CHECK(meter.total().count() == 0);
+}
+
+TEST_CASE("Uniform samples are integrated by chunks or one by one alike", "[calculus]")
+{
+    using power = si::power<double, std::kilo>;
+    std::vector<power> samples;
+    for (int i = 0; i < 1001; ++i) samples.emplace_back(std::sin(i * 0.01) + 2);
+    const double exact = 2 * 10 + (1 - std::cos(10.0));
+
+    for (std::size_t chunk : {1, 3, 16, 100, 1001}) {
+        si::uniform_integrator<power> trapezoid{si::time<double, std::milli>{10}};
+        si::uniform_integrator<power, si::rule::simpson> simpson{si::time<double, std::milli>{10}};
+        for (std::size_t i = 0; i < samples.size(); i += chunk) {
+            const auto n = std::min(chunk, samples.size() - i);
+            const si::span<const power> part{samples.data() + i, n};
+            trapezoid.push(part);
+            if (n == 1) {
+                simpson.push(part[0]);
+            } else {
+                simpson.push(part);
+            }
+        }
+        const si::energy<double, std::kilo> t = trapezoid.total();
+        const si::energy<double, std::kilo> s = simpson.total();
+        CHECK(t.count() == Approx(exact).epsilon(1e-5));
+        CHECK(s.count() == Approx(exact).epsilon(1e-11));
+        CHECK(std::abs(s.count() - exact) < std::abs(t.count() - exact));
+    }
+}
+
+TEST_CASE("Simpson's rule closes an odd interval with a trapezoid", "[calculus]")
+{
+    using power = si::power<double>;
+    si::uniform_integrator<power, si::rule::simpson> meter{si::second{1}};
+    meter.push(power{0});
+    CHECK(meter.total().count() == 0);
+    meter.push(power{2});
+    CHECK(meter.total().count() == Approx(1));
+    meter.push(power{4});
+    CHECK(meter.total().count() == Approx(4));
+    meter.push(power{9});
+    CHECK(meter.total().count() == Approx(4 + 6.5));
+
+    // x^2 from 0 to 2 with Simpson's rule, then a trapezoid from 2 to 3
+    std::vector<power> squares{power{0}, power{1}, power{4}, power{9}};
+    si::uniform_integrator<power, si::rule::simpson> squared{si::second{1}};
+    squared.push(squares);
+    CHECK(squared.total().count() == Approx(8.0 / 3 + 6.5));
+
+    squared.reset();
+    squared.push(std::vector<power>{power{0}, power{1}, power{4}});
+    CHECK(squared.total().count() == Approx(8.0 / 3));
+}
+
+TEST_CASE("Integer representations are integrated in floating point", "[calculus]")
+{
+    si::uniform_integrator<si::power<int, std::milli>> meter{si::millisecond{500}};
+    meter.push(std::vector<si::power<int, std::milli>>{si::power<int, std::milli>{1}, si::power<int, std::milli>{2}});
+    const si::energy<double, std::milli> consumed = meter.total();
+    CHECK(consumed.count() == Approx(0.75));
+}
+
+TEST_CASE("Timestamped samples are differentiated", "[calculus]")
+{
+    si::differentiator<si::length<double>, si::time<double, std::milli>> speed;
+    CHECK(speed.push(si::time<double, std::milli>{0}, si::length<double>{1}).count() == 0);
+    const si::velocity<double> v = speed.push(si::time<double, std::milli>{250}, si::length<double>{3});
+    CHECK(v.count() == Approx(8));
+    CHECK(speed.push(si::time<double, std::milli>{750}, si::length<double>{2}).count() == Approx(-2));
+}
+
+TEST_CASE("Uniform samples are differentiated by chunks", "[calculus]")
+{
+    using length = si::length<float>;
+    std::vector<length> samples;
+    for (int i = 0; i < 100; ++i) samples.emplace_back(static_cast<float>(i * i));
+    std::vector<si::velocity<float>> rates(samples.size(), si::velocity<float>{-1});
+
+    si::uniform_differentiator<length> speed{si::time<double, std::milli>{100}};
+    auto first = speed.push(si::span<const length>{samples.data(), 40}, si::span<si::velocity<float>>{rates});
+    REQUIRE(first.size() == 39);
+    auto rest = speed.push(si::span<length>{samples.data() + 40, 60},
+                           si::span<si::velocity<float>>{rates.data() + 39, 61});
+    REQUIRE(rest.size() == 60);
+    CHECK(rates.back().count() == -1);
+    // between i and i + 1 the rate of i^2 is (2i + 1) per 100 ms
+    for (std::size_t i = 0; i + 1 < samples.size(); ++i) CHECK(rates[i].count() == Approx((2 * i + 1) * 10.0));
+
+    CHECK(speed.push(si::span<const length>{}, si::span<si::velocity<float>>{}).empty());
+    speed.reset();
+    CHECK(speed.push(si::span<const length>{samples.data(), 1}, si::span<si::velocity<float>>{rates}).empty());
+}
@@ -0,0 +1,260 @@
+#include <catch.hpp>
+
+#include "si/charconv.hpp"
+#include "si/units.hpp"
+
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <system_error>
+
+namespace
+{
+template<typename _Unit>
+si::from_chars_result parse(const char *str, _Unit &value)
+{
+    return si::from_chars(str, str + std::strlen(str), value);
+}
+} // namespace
+
+TEST_CASE("Parsing units with a prefix", "[charconv]")
+{
+    SECTION("Floating point")
+    {
+        si::length<double> d;
+        const char *str = "12.5 km";
+        auto r = parse(str, d);
+        CHECK(r.ec == si::parse_errc::ok);
+        CHECK(r.ptr == str + 7);
+        CHECK(d.count() == 12500.0);
+
+        si::time<double> t;
+        CHECK(parse("300 ms", t).ec == si::parse_errc::ok);
+        CHECK(t.count() == 0.3);
+
+        si::length<float, std::kilo> km;
+        CHECK(parse("250m", km).ec == si::parse_errc::ok);
+        CHECK(km.count() == 0.25f);
+    }
+
+    SECTION("Integral")
+    {
+        si::millisecond ms;
+        CHECK(parse("42 s", ms).ec == si::parse_errc::ok);
+        CHECK(ms.count() == 42000);
+
+        CHECK(parse("-1500 us", ms).ec == si::parse_errc::ok);
+        CHECK(ms.count() == -1);
+
+        CHECK(parse("1.5 s", ms).ec == si::parse_errc::ok);
+        CHECK(ms.count() == 1500);
+
+        si::gram g;
+        CHECK(parse("3 kg", g).ec == si::parse_errc::ok);
+        CHECK(g.count() == 3000);
+
+        si::kilogram kg;
+        CHECK(parse("3 kg", kg).ec == si::parse_errc::ok);
+        CHECK(kg.count() == 3);
+
+        si::meter m;
+        CHECK(parse("4 dam", m).ec == si::parse_errc::ok);
+        CHECK(m.count() == 40);
+    }
+
+    SECTION("Every prefix")
+    {
+        si::length<long double, std::atto> am;
+        const char *prefixes[] = {"a", "f", "p", "n", "u", "µ", "μ", "m", "c", "d",
+                                  "", "da", "h", "k", "M"};
+        const long double expected[] = {1, 1e3, 1e6, 1e9, 1e12, 1e12, 1e12, 1e15, 1e16, 1e17,
+                                        1e18, 1e19, 1e20, 1e21, 1e24};
+        for (std::size_t i = 0; i < std::size(prefixes); ++i) {
+            std::string str = std::string("1 ") + prefixes[i] + "m";
+            CHECK(si::from_chars(str.data(), str.data() + str.size(), am).ec == si::parse_errc::ok);
+            CHECK(am.count() == Approx(expected[i]));
+        }
+
+        si::length<double, std::exa> em;
+        CHECK(parse("2 Gm", em).ec == si::parse_errc::ok);
+        CHECK(em.count() == Approx(2e-9));
+        CHECK(parse("2 Tm", em).ec == si::parse_errc::ok);
+        CHECK(parse("2 Pm", em).ec == si::parse_errc::ok);
+        CHECK(em.count() == Approx(2e-3));
+        CHECK(parse("2 Em", em).ec == si::parse_errc::ok);
+        CHECK(em.count() == 2.0);
+    }
+}
+
+TEST_CASE("Parsing derived units", "[charconv]")
+{
+    si::pressure<double> pa;
+    CHECK(parse("4.2e3 Pa", pa).ec == si::parse_errc::ok);
+    CHECK(si::unit_cast<si::pressure<double, std::kilo>>(pa).count() == Approx(4.2e3));
+
+    si::force<double, std::kilo> n;
+    CHECK(parse("2 kN", n).ec == si::parse_errc::ok);
+    CHECK(n.count() == Approx(2000.0));
+
+    si::electric_resistance<double, std::kilo> ohm;
+    CHECK(parse("47 kΩ", ohm).ec == si::parse_errc::ok);
+    CHECK(ohm.count() == Approx(47000.0));
+    CHECK(parse("47 kohm", ohm).ec == si::parse_errc::ok);
+    CHECK(ohm.count() == Approx(47000.0));
+
+    si::luminous_intensity<int> cd;
+    CHECK(parse("5 cd", cd).ec == si::parse_errc::ok);
+    CHECK(cd.count() == 5);
+
+    si::frequency<int> hz;
+    CHECK(parse("3 kHz", hz).ec == si::parse_errc::ok);
+    CHECK(hz.count() == 3000);
+
+    si::angle<double> rad;
+    CHECK(parse("0.5", rad).ec == si::parse_errc::ok);
+    CHECK(rad.count() == 0.5);
+    CHECK(parse("2 rad", rad).ec == si::parse_errc::ok);
+    CHECK(rad.count() == 2.0);
+}
+
+TEST_CASE("Parsing errors", "[charconv]")
+{
+    si::length<double> d{7.0};
+
+    const char *invalid = "km";
+    auto r = parse(invalid, d);
+    CHECK(r.ec == si::parse_errc::invalid_number);
+    CHECK(r.ptr == invalid);
+
+    const char *unknown = "3 furlong";
+    r = parse(unknown, d);
+    CHECK(r.ec == si::parse_errc::unknown_unit);
+    CHECK(r.ptr == unknown + 2);
+
+    const char *mismatch = "3 ms";
+    r = parse(mismatch, d);
+    CHECK(r.ec == si::parse_errc::dimension_mismatch);
+    CHECK(r.ptr == mismatch + 2);
+
+    CHECK(parse("3", d).ec == si::parse_errc::dimension_mismatch);
+    CHECK(parse("3 kg", d).ec == si::parse_errc::dimension_mismatch);
+
+    CHECK(d.count() == 7.0);
+
+    si::length<int32_t, std::milli> mm;
+    CHECK(parse("3000 km", mm).ec == si::parse_errc::out_of_range);
+    CHECK(parse("3e9 mm", mm).ec == si::parse_errc::out_of_range);
+    CHECK(parse("99999999999999999999 mm", mm).ec == si::parse_errc::out_of_range);
+
+    si::length<float> f;
+    CHECK(parse("1e300 m", f).ec == si::parse_errc::out_of_range);
+}
+
+TEST_CASE("Parsing stops at the end of the symbol", "[charconv]")
+{
+    const char *str = "5 m, 6 s";
+    si::meter m;
+    auto r = parse(str, m);
+    CHECK(r.ec == si::parse_errc::ok);
+    CHECK(m.count() == 5);
+    CHECK(*r.ptr == ',');
+
+    si::second s;
+    r = si::from_chars(r.ptr + 2, str + std::strlen(str), s);
+    CHECK(r.ec == si::parse_errc::ok);
+    CHECK(s.count() == 6);
+    CHECK(r.ptr == str + std::strlen(str));
+}
+
+namespace
+{
+template<typename _Unit>
+std::string format(const _Unit &value, si::prefix_mode mode = si::prefix_mode::exact)
+{
+    char buffer[64];
+    auto r = si::to_chars(buffer, buffer + sizeof(buffer), value, mode);
+    REQUIRE(r.ec == std::errc{});
+    return std::string(buffer, r.ptr);
+}
+} // namespace
+
+TEST_CASE("Formatting units with the prefix of their ratio", "[charconv]")
+{
+    CHECK(format(si::length<double, std::kilo>{3.2}) == "3.2 km");
+    CHECK(format(si::millisecond{15}) == "15 ms");
+    CHECK(format(si::microsecond{-4}) == "-4 µs");
+    CHECK(format(si::gram{12}) == "12 g");
+    CHECK(format(si::kilogram{12}) == "12 kg");
+    CHECK(format(si::decameter{1}) == "1 dam");
+    CHECK(format(si::force<int, std::kilo>{2}) == "2 kg·m·s⁻²");
+    CHECK(format(si::force<int>{2}) == "2 g·m·s⁻²");
+    CHECK(format(si::velocity<float>{1.5f}) == "1.5 m·s⁻¹");
+    CHECK(format(si::capacitance<int>{1}) == "1 g⁻¹·m⁻²·s⁴·A²");
+    CHECK(format(si::unit<int, std::ratio<1>, si::detail::_m<12>>{1}) == "1 m¹²");
+    CHECK(format(si::angle<double>{0.5}) == "0.5");
+}
+
+TEST_CASE("Formatting units whose ratio is not a prefix", "[charconv]")
+{
+    // a thousandth of a square metre is not a mm², which is a millionth
+    CHECK(format(si::area<int, std::milli>{5}) == "0.005 m²");
+    CHECK(format(si::area<int, std::micro>{5}) == "5 mm²");
+    CHECK(format(si::length<int, std::ratio<1, 4>>{3}) == "0.75 m");
+    CHECK(format(si::angle<int, std::milli>{250}) == "0.25");
+}
+
+TEST_CASE("Formatting units with an automatic prefix", "[charconv]")
+{
+    const auto automatic = si::prefix_mode::automatic;
+    CHECK(format(si::meter{12500}, automatic) == "12.5 km");
+    CHECK(format(si::length<double>{0.0032}, automatic) == "3.2 mm");
+    CHECK(format(si::length<double>{-0.0032}, automatic) == "-3.2 mm");
+    CHECK(format(si::gram{1500}, automatic) == "1.5 kg");
+    CHECK(format(si::millisecond{1}, automatic) == "1 ms");
+    CHECK(format(si::nanosecond{999}, automatic) == "999 ns");
+    CHECK(format(si::second{0}, automatic) == "0 s");
+    CHECK_THAT(format(si::length<double>{1e-30}, automatic), Catch::EndsWith("e-12 am"));
+    CHECK_THAT(format(si::length<double>{1e30}, automatic), Catch::EndsWith("e+12 Em"));
+    CHECK(format(si::area<double>{2e6}, automatic) == "2 km²");
+    CHECK(format(si::frequency<double>{2e3}, automatic) == "2 ms⁻¹");
+}
+
+TEST_CASE("Formatting into a buffer too small", "[charconv]")
+{
+    char buffer[5];
+    auto r = si::to_chars(buffer, buffer + sizeof(buffer), si::millisecond{1234});
+    CHECK(r.ec == std::errc::value_too_large);
+    CHECK(r.ptr == buffer + sizeof(buffer));
+
+    r = si::to_chars(buffer, buffer + sizeof(buffer), si::millisecond{123});
+    CHECK(r.ec == std::errc::value_too_large);
+}
+
+TEST_CASE("Formatted units can be parsed back", "[charconv]")
+{
+    const si::length<double, std::micro> value{12.25};
+    char buffer[64];
+    auto w = si::to_chars(buffer, buffer + sizeof(buffer), value);
+
+    si::length<double, std::micro> parsed;
+    auto r = si::from_chars(buffer, w.ptr, parsed);
+    CHECK(r.ec == si::parse_errc::ok);
+    CHECK(r.ptr == w.ptr);
+    CHECK(parsed.count() == value.count());
+}
+
+#if SI_HAS_INT128
+TEST_CASE("Parsing and formatting 128 bit units", "[charconv]")
+{
+    si::time<si::int128_t, std::nano> ns;
+    CHECK(parse("9000000000 Ms", ns).ec == si::parse_errc::ok);
+    CHECK(ns.count() == si::int128_t{9000000000} * 1000000000000000);
+    CHECK(format(ns) == "9000000000000000000000000 ns");
+    CHECK(format(si::time<si::int128_t, std::nano>{-1500}, si::prefix_mode::automatic) == "-1.5 µs");
+    CHECK(format(si::length<si::uint128_t>{~si::uint128_t{0}}) == "340282366920938463463374607431768211455 m");
+
+    si::length<uint64_t> m;
+    CHECK(parse("5 km", m).ec == si::parse_errc::ok);
+    CHECK(m.count() == 5000);
+}
+#endif
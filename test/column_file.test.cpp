@@ -0,0 +1,139 @@
+#include <catch.hpp>
+
+#include "si/column_file.hpp"
+#include "si/half.hpp"
+#include "si/units.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::string temporary_path(const char *name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+} // namespace
+
+TEST_CASE("Writing and mapping column files", "[column_file]")
+{
+    const auto path = temporary_path("si_column_file.test.sicol");
+
+    std::vector<si::time<std::int64_t, std::micro>> times;
+    std::list<si::pressure<double>> pressures;  // not contiguous, streamed through a buffer
+    for (int i = 0; i < 1000; ++i) {
+        times.emplace_back(i * 250);
+        pressures.emplace_back(101325.0 + i);
+    }
+    const si::temperature<float> temperatures[] = {si::temperature<float>{293.15f}, si::temperature<float>{294.5f}};
+
+    {
+        si::column_writer w;
+        REQUIRE(w.open(path.c_str()) == si::column_errc::ok);
+        CHECK(w.write("time", times) == si::column_errc::ok);
+        CHECK(w.write("pressure", pressures) == si::column_errc::ok);
+        CHECK(w.write("temperature", temperatures) == si::column_errc::ok);
+        CHECK(w.write("time", times) == si::column_errc::invalid_name);
+        CHECK(w.write("", times) == si::column_errc::invalid_name);
+        CHECK(w.write(std::string(57, 'x'), times) == si::column_errc::invalid_name);
+        CHECK(w.close() == si::column_errc::ok);
+    }
+
+    si::column_file f;
+    REQUIRE(f.open(path.c_str()) == si::column_errc::ok);
+    REQUIRE(f.columns() == 3);
+
+    SECTION("Columns are spans into the mapping")
+    {
+        si::span<const si::time<std::int64_t, std::micro>> t;
+        REQUIRE(f.column("time", t) == si::column_errc::ok);
+        REQUIRE(t.size() == times.size());
+        CHECK(reinterpret_cast<std::uintptr_t>(t.data()) % 64 == 0);
+        CHECK(std::equal(t.begin(), t.end(), times.begin()));
+
+        si::span<const si::pressure<double>> p;
+        REQUIRE(f.column("pressure", p) == si::column_errc::ok);
+        CHECK(std::equal(p.begin(), p.end(), pressures.begin(), pressures.end()));
+
+        si::span<const si::temperature<float>> k;
+        REQUIRE(f.column(2, k) == si::column_errc::ok);
+        CHECK(std::equal(k.begin(), k.end(), std::begin(temperatures), std::end(temperatures)));
+    }
+
+    SECTION("Opening a column as another unit is refused")
+    {
+        si::span<const si::length<std::int64_t, std::micro>> length;
+        CHECK(f.column("time", length) == si::column_errc::dimension_mismatch);
+        si::span<const si::time<std::int64_t, std::milli>> ms;
+        CHECK(f.column("time", ms) == si::column_errc::ratio_mismatch);
+        si::span<const si::time<std::uint64_t, std::micro>> unsigned_us;
+        CHECK(f.column("time", unsigned_us) == si::column_errc::rep_mismatch);
+        si::span<const si::pressure<float>> single;
+        CHECK(f.column("pressure", single) == si::column_errc::rep_mismatch);
+        CHECK(f.column("humidity", single) == si::column_errc::not_found);
+        CHECK(f.column(3, single) == si::column_errc::not_found);
+        CHECK(length.size() == 0);
+    }
+
+    SECTION("The directory describes columns of runtime types")
+    {
+        const auto info = f.info(1);
+        CHECK(info.name() == "pressure");
+        CHECK(info.dim() == si::dimension_of<si::pressure<double>::base>);
+        CHECK(info.ratio_num() == si::pressure<double>::ratio::num);
+        CHECK(info.ratio_den() == si::pressure<double>::ratio::den);
+        CHECK(info.rep() == si::rep_type::float64);
+        CHECK(info.size() == 1000);
+        CHECK(f.bytes(1).size() == 8000);
+        CHECK(f.info(0).rep() == si::rep_type::int64);
+        CHECK(f.info(2).rep() == si::rep_type::float32);
+
+        static_assert(si::detail::rep_type_of<si::bfloat16>() == si::rep_type::bfloat16, "");
+#if SI_HAS_FLOAT16
+        static_assert(si::detail::rep_type_of<si::float16_t>() == si::rep_type::float16, "");
+#endif
+    }
+
+    f.close();
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Invalid column files are refused", "[column_file]")
+{
+    const auto path = temporary_path("si_column_file.invalid.sicol");
+    si::column_file f;
+
+    CHECK(f.open(temporary_path("si_column_file.missing.sicol").c_str()) == si::column_errc::io_error);
+
+    SECTION("Not a column file")
+    {
+        std::FILE *file = std::fopen(path.c_str(), "wb");
+        REQUIRE(file);
+        std::fputs("time,pressure\n0,101325\n250,101326\n", file);
+        std::fclose(file);
+        CHECK(f.open(path.c_str()) == si::column_errc::invalid_format);
+        CHECK_FALSE(f.is_open());
+    }
+
+    SECTION("Truncated column file")
+    {
+        {
+            si::column_writer w;
+            REQUIRE(w.open(path.c_str()) == si::column_errc::ok);
+            const std::vector<si::meter> lengths(100, si::meter{1});
+            CHECK(w.write("length", lengths) == si::column_errc::ok);
+        }
+        REQUIRE(f.open(path.c_str()) == si::column_errc::ok);
+        f.close();
+
+        std::filesystem::resize_file(path, 256);
+        CHECK(f.open(path.c_str()) == si::column_errc::invalid_format);
+    }
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,143 @@
+#include <catch.hpp>
+
+#include "si/convert.hpp"
+#include "si/units.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+template<typename _From>
+std::vector<_From> make_input(std::size_t n)
+{
+    std::vector<_From> v;
+    for (std::size_t i = 0; i < n; ++i) {
+        auto x = static_cast<typename _From::rep>(i * 7919 % 100003);
+        v.emplace_back(i % 3 == 0 ? -x : x);
+    }
+    return v;
+}
+
+template<typename _To, typename _From>
+void check_convert(std::size_t n)
+{
+    const auto in = make_input<_From>(n);
+    std::vector<_To> out(n);
+
+    auto written = si::convert(si::span<const _From>{in}, si::span<_To>{out});
+    REQUIRE(written.size() == n);
+    CHECK(written.data() == out.data());
+
+    for (std::size_t i = 0; i < n; ++i) {
+        CHECK(out[i].count() == si::unit_cast<_To>(in[i]).count());
+    }
+}
+} // namespace
+
+TEST_CASE("Batch conversion matches unit_cast", "[convert]")
+{
+    for (std::size_t n : {0, 1, 15, 16, 17, 100, 1000}) {
+        check_convert<si::time<int32_t, std::milli>, si::time<int32_t, std::nano>>(n);
+        check_convert<si::time<int64_t, std::nano>, si::time<int64_t, std::milli>>(n);
+        check_convert<si::mass<int64_t>, si::mass<int64_t, std::milli>>(n);
+        check_convert<si::length<float>, si::length<float, std::milli>>(n);
+        check_convert<si::length<double, std::kilo>, si::length<double>>(n);
+        check_convert<si::length<double>, si::length<int32_t, std::micro>>(n);
+        check_convert<si::length<int32_t>, si::length<int32_t>>(n);
+    }
+}
+
+TEST_CASE("Batch conversion only writes the size of the input", "[convert]")
+{
+    const std::vector<si::millisecond> in{si::millisecond{1}, si::millisecond{2}};
+    std::vector<si::microsecond> out(4, si::microsecond{-1});
+
+    auto written = si::convert(si::span<const si::millisecond>{in}, si::span<si::microsecond>{out});
+    CHECK(written.size() == 2);
+    CHECK(out[0].count() == 1000);
+    CHECK(out[1].count() == 2000);
+    CHECK(out[2].count() == -1);
+    CHECK(out[3].count() == -1);
+}
+
+TEST_CASE("Batch conversion accepts mutable input", "[convert]")
+{
+    std::vector<si::second> in{si::second{3}};
+    std::vector<si::millisecond> out(1);
+
+    si::convert(si::span<si::second>{in}, si::span<si::millisecond>{out});
+    CHECK(out[0].count() == 3000);
+}
+
+#if SI_CONVERT_X86_DISPATCH
+TEST_CASE("Every kernel supported by this machine gives the same result", "[convert]")
+{
+    using from = si::time<int32_t, std::nano>;
+    using to   = si::time<int32_t, std::micro>;
+    const auto in = make_input<from>(123);
+    std::vector<to> expected(in.size());
+    si::detail::convert_scalar(in.data(), expected.data(), in.size());
+
+    const auto isa = si::detail::native_isa();
+    std::vector<to> out(in.size());
+    auto check = [&] {
+        for (std::size_t i = 0; i < in.size(); ++i) {
+            CHECK(out[i].count() == expected[i].count());
+        }
+    };
+
+    if (isa >= si::detail::isa::sse2) {
+        si::detail::convert_sse2(in.data(), out.data(), in.size());
+        check();
+    }
+    if (isa >= si::detail::isa::avx2) {
+        si::detail::convert_avx2(in.data(), out.data(), in.size());
+        check();
+    }
+    if (isa >= si::detail::isa::avx512) {
+        si::detail::convert_avx512(in.data(), out.data(), in.size());
+        check();
+    }
+}
+
+TEST_CASE("The avx512dq kernel gives the same result for 64 bit integers", "[convert]")
+{
+    if (si::detail::native_isa() < si::detail::isa::avx512dq) return;
+
+    using from = si::time<int64_t, std::nano>;
+    using to   = si::time<double>;
+    const auto in = make_input<from>(123);
+    std::vector<to> expected(in.size()), out(in.size());
+    si::detail::convert_scalar(in.data(), expected.data(), in.size());
+    si::detail::convert_avx512dq(in.data(), out.data(), in.size());
+    for (std::size_t i = 0; i < in.size(); ++i) CHECK(out[i].count() == expected[i].count());
+
+    std::vector<from> back(in.size()), expected_back(in.size());
+    si::detail::convert_scalar(expected.data(), expected_back.data(), in.size());
+    si::detail::convert_avx512dq(expected.data(), back.data(), in.size());
+    for (std::size_t i = 0; i < in.size(); ++i) CHECK(back[i].count() == expected_back[i].count());
+}
+#endif
+
+TEST_CASE("Arrays of durations are converted to time units of another ratio", "[convert]")
+{
+    namespace chrono = std::chrono;
+
+    std::vector<chrono::nanoseconds> deadlines;
+    for (int i = 0; i < 100; ++i) deadlines.emplace_back(i * 1500);
+
+    std::vector<si::time<double, std::micro>> times(deadlines.size() + 1);
+    auto written = si::from_durations(si::span<chrono::nanoseconds>{deadlines},
+                                      si::span<si::time<double, std::micro>>{times});
+    REQUIRE(written.size() == deadlines.size());
+    for (std::size_t i = 0; i < deadlines.size(); ++i) CHECK(times[i].count() == i * 1.5);
+
+    std::vector<chrono::milliseconds> rounded(deadlines.size());
+    si::to_durations(si::span<const si::time<double, std::micro>>{times}.first(deadlines.size()),
+                     si::span<chrono::milliseconds>{rounded});
+    for (std::size_t i = 0; i < deadlines.size(); ++i) {
+        CHECK(rounded[i] == chrono::milliseconds{static_cast<long>(i * 1.5 / 1000)});
+    }
+}
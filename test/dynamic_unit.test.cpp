@@ -0,0 +1,180 @@
+#include <catch.hpp>
+
+#include "si/dynamic_unit.hpp"
+#include "si/units.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+TEST_CASE("Packed dimensions", "[dynamic_unit]")
+{
+    SECTION("Exponents are packed 4 bits each")
+    {
+        constexpr si::dimension d{1, -2, 3, -4, 5, -6, 7};
+        static_assert(d.valid(), "");
+        CHECK(d.m() == 1);
+        CHECK(d.g() == -2);
+        CHECK(d.s() == 3);
+        CHECK(d.A() == -4);
+        CHECK(d.K() == 5);
+        CHECK(d.mol() == -6);
+        CHECK(d.cd() == 7);
+        CHECK(si::dimension{}.bits() == 0);
+        CHECK(si::dimension{-1, 0, 0, 0, 0, 0, 0}.bits() == 0xf);
+    }
+
+    SECTION("Dimensions of static units")
+    {
+        constexpr auto capacitance = si::dimension_of<si::capacitance<int>::base>;
+        CHECK(capacitance == si::dimension{-2, -1, 4, 2, 0, 0, 0});
+        CHECK(capacitance != si::dimension_of<si::inductance<int>::base>);
+    }
+
+    SECTION("Multiplying and dividing add and subtract every exponent")
+    {
+        const auto length = si::dimension_of<si::length<int>::base>;
+        const auto time = si::dimension_of<si::time<int>::base>;
+        const auto force = si::dimension_of<si::force<int>::base>;
+
+        CHECK(length / time / time == si::dimension_of<si::acceleration<int>::base>);
+        CHECK(force * length / time == si::dimension_of<si::power<int>::base>);
+        CHECK(force / (length * length) == si::dimension_of<si::pressure<int>::base>);
+        CHECK(si::dimension{} / time == si::dimension_of<si::frequency<int>::base>);
+        CHECK(time / time == si::dimension{});
+
+        // every pair of exponents in every position, next to exponents that carry or
+        // borrow themselves
+        for (int i = 0; i < 7; ++i) {
+            for (int a = si::dimension::min_exponent; a <= si::dimension::max_exponent; ++a) {
+                for (int b = si::dimension::min_exponent; b <= si::dimension::max_exponent; ++b) {
+                    int xs[7] = {-1, 3, -4, 2, -1, 1, -3};
+                    int ys[7] = {-1, 3, 4, -3, -2, 1, 2};
+                    xs[i] = a;
+                    ys[i] = b;
+                    const si::dimension x{xs[0], xs[1], xs[2], xs[3], xs[4], xs[5], xs[6]};
+                    const si::dimension y{ys[0], ys[1], ys[2], ys[3], ys[4], ys[5], ys[6]};
+
+                    int sum[7], difference[7];
+                    bool sum_fits = true, difference_fits = true;
+                    for (int k = 0; k < 7; ++k) {
+                        sum[k] = xs[k] + ys[k];
+                        difference[k] = xs[k] - ys[k];
+                        sum_fits &= sum[k] >= -8 && sum[k] <= 7;
+                        difference_fits &= difference[k] >= -8 && difference[k] <= 7;
+                    }
+                    REQUIRE((x * y).valid() == sum_fits);
+                    REQUIRE((x / y).valid() == difference_fits);
+                    if (sum_fits) {
+                        REQUIRE(x * y == si::dimension{sum[0], sum[1], sum[2], sum[3], sum[4], sum[5], sum[6]});
+                    }
+                    if (difference_fits) {
+                        REQUIRE(x / y == si::dimension{difference[0], difference[1], difference[2], difference[3],
+                                                       difference[4], difference[5], difference[6]});
+                    }
+                }
+            }
+        }
+    }
+
+    SECTION("Invalid dimensions propagate and never compare equal")
+    {
+        const si::dimension big{7, 0, 0, 0, 0, 0, 0};
+        CHECK_FALSE((big * big).valid());
+        CHECK_FALSE(((big * big) / big).valid());
+        CHECK_FALSE(si::dimension{9, 0, 0, 0, 0, 0, 0}.valid());
+        CHECK(si::dimension::invalid() != si::dimension::invalid());
+    }
+}
+
+TEST_CASE("Dynamic units", "[dynamic_unit]")
+{
+    SECTION("Built from static units")
+    {
+        const si::dynamic_unit km = si::length<int, std::kilo>{3};
+        CHECK(km.count() == 3.0);
+        CHECK(km.scale() == 1000.0);
+        CHECK(km.coherent() == 3000.0);
+        CHECK(km.dim() == si::dimension_of<si::length<int>::base>);
+
+        const si::dynamic_unit kg = si::kilogram{2};
+        CHECK(kg.coherent() == 2000.0);
+    }
+
+    SECTION("Arithmetic")
+    {
+        const si::dynamic_unit km = si::length<int, std::kilo>{3};
+        const si::dynamic_unit mm = si::length<int, std::milli>{500};
+        const si::dynamic_unit s = si::second{2};
+
+        const auto sum = km + mm;
+        CHECK(sum.scale() == 1000.0);
+        CHECK(sum.count() == Approx(3.0005));
+        CHECK((mm - km).coherent() == Approx(-2999.5));
+
+        const auto v = km / s;
+        CHECK(v.dim() == si::dimension_of<si::velocity<int>::base>);
+        CHECK(v.coherent() == Approx(1500.0));
+        CHECK((v * s) == km);
+        CHECK((2.0 * km).coherent() == 6000.0);
+        CHECK((km / 2.0).coherent() == 1500.0);
+        CHECK((1.0 / s).dim() == si::dimension_of<si::frequency<int>::base>);
+        CHECK((1.0 / s).coherent() == 0.5);
+
+        CHECK(mm < km);
+        CHECK(km > mm);
+        CHECK(km >= km);
+        CHECK(km == si::dynamic_unit{si::meter{3000}});
+    }
+
+    SECTION("Mixing dimensions gives an invalid result")
+    {
+        const si::dynamic_unit m = si::meter{1};
+        const si::dynamic_unit s = si::second{1};
+
+        const auto sum = m + s;
+        CHECK_FALSE(sum.dim().valid());
+        CHECK(std::isnan(sum.count()));
+        CHECK_FALSE(sum == sum);
+        CHECK_FALSE(m < s);
+        CHECK_FALSE(s < m);
+        CHECK_FALSE(m == s);
+        CHECK_FALSE((sum * m).dim().valid());
+    }
+}
+
+TEST_CASE("Converting dynamic units to static units", "[dynamic_unit]")
+{
+    SECTION("Matching dimensions are converted to the ratio of the static unit")
+    {
+        si::length<double, std::milli> mm;
+        CHECK(si::unit_cast(si::dynamic_unit{si::length<int, std::kilo>{3}}, mm) == si::dynamic_errc::ok);
+        CHECK(mm.count() == 3000000.0);
+
+        si::meter m;
+        CHECK(si::unit_cast(si::dynamic_unit{si::length<int, std::milli>{2500}}, m) == si::dynamic_errc::ok);
+        CHECK(m.count() == 2);
+
+        si::gram g;
+        CHECK(si::unit_cast(si::dynamic_unit{si::kilogram{4}}, g) == si::dynamic_errc::ok);
+        CHECK(g.count() == 4000);
+    }
+
+    SECTION("The same scale round trips exactly")
+    {
+        const si::length<int64_t, std::micro> big{std::numeric_limits<int64_t>::max() / 1024};
+        si::length<int64_t, std::micro> back;
+        CHECK(si::unit_cast(si::dynamic_unit{big}, back) == si::dynamic_errc::ok);
+        CHECK(back.count() == big.count());
+    }
+
+    SECTION("Errors leave the static unit unchanged")
+    {
+        si::meter m{7};
+        CHECK(si::unit_cast(si::dynamic_unit{si::second{1}}, m) == si::dynamic_errc::dimension_mismatch);
+        CHECK(si::unit_cast(si::dynamic_unit{si::meter{1}} + si::dynamic_unit{si::second{1}}, m)
+              == si::dynamic_errc::dimension_mismatch);
+        CHECK(si::unit_cast(si::dynamic_unit{si::length<double, std::exa>{1}}, m) == si::dynamic_errc::out_of_range);
+        CHECK(m.count() == 7);
+    }
+}
@@ -0,0 +1,103 @@
+#include <catch.hpp>
+
+#include "si/expression.hpp"
+#include "si/units.hpp"
+
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+template<typename T, typename U, typename = void>
+struct can_add : std::false_type {};
+
+template<typename T, typename U>
+struct can_add<T, U, std::void_t<decltype(std::declval<T>() + std::declval<U>())>> : std::true_type {};
+
+using force_vector    = si::unit_vector<si::force<double>>;
+using length_vector   = si::unit_vector<si::length<double>>;
+using energy_vector   = si::unit_vector<si::energy<double>>;
+} // namespace
+
+TEST_CASE("Expressions are lazy and typed by the unit operators", "[expression]")
+{
+    force_vector f{si::force<double>{1}, si::force<double>{2}, si::force<double>{3}};
+    length_vector d{si::length<double>{4}, si::length<double>{5}, si::length<double>{6}};
+
+    auto e = f * d;
+    CHECK(std::is_same<decltype(e)::value_type, si::energy<double>>::value);
+    CHECK(e.size() == 3);
+    CHECK(e[1].count() == 10);
+
+    // the expression only references its operands
+    d[1] = si::length<double>{0.5};
+    CHECK(e[1].count() == 1);
+}
+
+TEST_CASE("Expressions check dimensions at compile time", "[expression]")
+{
+    CHECK(can_add<const energy_vector &, const energy_vector &>::value);
+    CHECK(can_add<const length_vector &, si::length<double, std::milli>>::value);
+    CHECK(can_add<decltype(std::declval<force_vector>() * std::declval<length_vector>()),
+                  const energy_vector &>::value);
+    CHECK_FALSE(can_add<const force_vector &, const length_vector &>::value);
+    CHECK_FALSE(can_add<const length_vector &, si::second>::value);
+    CHECK_FALSE(can_add<const length_vector &, std::vector<double>>::value);
+}
+
+TEST_CASE("Evaluating fused expressions", "[expression]")
+{
+    const std::size_t n = 37;
+    force_vector f;
+    length_vector d;
+    energy_vector other;
+    for (std::size_t i = 0; i < n; ++i) {
+        f.emplace_back(i);
+        d.emplace_back(2.0);
+        other.emplace_back(0.5);
+    }
+
+    SECTION("evaluate returns the natural unit of the expression")
+    {
+        auto e = si::evaluate(f * d + other);
+        REQUIRE(e.size() == n);
+        for (std::size_t i = 0; i < n; ++i) CHECK(e[i].count() == Approx(2.0 * i + 0.5));
+    }
+    SECTION("assign converts to the destination unit")
+    {
+        si::unit_vector<si::energy<double, std::kilo>> kilo;
+        si::assign(kilo, f * d - other);
+        REQUIRE(kilo.size() == n);
+        for (std::size_t i = 0; i < n; ++i) CHECK(kilo[i].count() == Approx((2.0 * i - 0.5) / 1000));
+    }
+    SECTION("assign into a span")
+    {
+        std::vector<si::energy<double>> out(n);
+        auto written = si::assign(si::span<si::energy<double>>{out}, f * d / 2.0);
+        CHECK(written.size() == n);
+        CHECK(out[n - 1].count() == Approx(n - 1));
+    }
+    SECTION("scalar units and numbers are broadcast")
+    {
+        auto e = si::evaluate(2.0 * (d - si::length<double, std::milli>{500}) * si::length<double>{3});
+        CHECK(std::is_same<decltype(e)::value_type, si::area<double, std::milli>>::value);
+        CHECK(e[0].count() == Approx(9000));
+    }
+    SECTION("an operand can be assigned to")
+    {
+        si::assign(d, d * 3.0 + si::length<double>{1});
+        CHECK(d[0].count() == Approx(7));
+        CHECK(d[n - 1].count() == Approx(7));
+    }
+}
+
+TEST_CASE("Mixed ratio and integral expressions", "[expression]")
+{
+    si::unit_vector<si::millimeter> mm{si::millimeter{1}, si::millimeter{2}};
+    si::unit_vector<si::meter> m{si::meter{1}, si::meter{2}};
+
+    auto sum = si::evaluate(mm + m);
+    CHECK(std::is_same<decltype(sum)::value_type, si::millimeter>::value);
+    CHECK(sum[0].count() == 1001);
+    CHECK(sum[1].count() == 2002);
+}
@@ -0,0 +1,152 @@
+#include <catch.hpp>
+
+#include "si/fixed.hpp"
+#include "si/units.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+namespace
+{
+using q16 = si::fixed<std::int32_t, 16>;
+using q8 = si::fixed<std::int32_t, 8>;
+using q32 = si::fixed<std::int64_t, 32>;
+
+template<si::rounding _Rounding>
+using q4 = si::fixed<std::int32_t, 4, _Rounding>;
+
+// the exact result, rounded as _Rounding says
+template<si::rounding _Rounding>
+std::int64_t rounded(long double exact)
+{
+    switch (_Rounding) {
+    case si::rounding::toward_zero: return static_cast<std::int64_t>(std::trunc(exact));
+    case si::rounding::down: return static_cast<std::int64_t>(std::floor(exact));
+    case si::rounding::nearest: return static_cast<std::int64_t>(std::floor(exact + 0.5L));
+    }
+    return 0;
+}
+
+template<si::rounding _Rounding>
+void check_rounding()
+{
+    using from = si::length<q4<_Rounding>, std::milli>;
+    using to = si::length<q4<_Rounding>>;
+    for (std::int32_t raw = -40000; raw <= 40000; raw += 7) {
+        const auto converted = si::unit_cast<to>(from{q4<_Rounding>::from_raw(raw)});
+        REQUIRE(converted.count().raw() == rounded<_Rounding>(raw / 1000.0L));
+    }
+}
+} // namespace
+
+TEST_CASE("Fixed point numbers", "[fixed]")
+{
+    SECTION("Construction and conversions")
+    {
+        constexpr q16 three = 3;
+        static_assert(three.raw() == 3 << 16, "");
+        static_assert(q16{1.5}.raw() == 0x18000, "");
+        static_assert(q16{-1.5}.raw() == -0x18000, "");
+        static_assert(static_cast<double>(q16::from_raw(0x8000)) == 0.5, "");
+        static_assert(static_cast<int>(q16{2.5}) == 3, "");
+        static_assert(static_cast<int>(si::fixed<std::int32_t, 16, si::rounding::toward_zero>{-2.5}) == -2, "");
+        static_assert(static_cast<int>(si::fixed<std::int32_t, 16, si::rounding::down>{-2.25}) == -3, "");
+        static_assert(q8{q16{1.25}}.raw() == 0x140, "");
+
+        static_assert(std::is_convertible<int, q16>::value, "");
+        static_assert(!std::is_convertible<double, q16>::value, "");
+        static_assert(!std::is_convertible<q16, int>::value, "");
+    }
+
+    SECTION("Arithmetic")
+    {
+        CHECK(q16{1.5} + q16{2} == q16{3.5});
+        CHECK(q16{1.5} - 2 == q16{-0.5});
+        CHECK(q16{1.5} * q16{-2.25} == q16{-3.375});
+        CHECK(q16{1} / q16{3} == q16::from_raw(21845));
+        CHECK(q16{2} / q16{3} == q16::from_raw(43691));
+        CHECK(q16{7.5} * 2 == q16{15});
+        CHECK(q16{7.5} / 2 == q16{3.75});
+        CHECK(3 / q16{2} == q16{1.5});
+        CHECK(q16{1} < q16{1.5});
+
+        // mixed scales are computed in the common type, from the raw values
+        const auto p = q8{1.5} * q16{0.25};
+        static_assert(std::is_same<decltype(p), const q16>::value, "");
+        CHECK(p == q16{0.375});
+        CHECK(q8{3} / q16{0.5} == q16{6});
+        CHECK(q16{1.25} * q32{2} == q32{2.5});
+    }
+
+    SECTION("Common types")
+    {
+        static_assert(std::is_same<std::common_type_t<q8, q16>, q16>::value, "");
+        static_assert(std::is_same<std::common_type_t<q16, std::int64_t>, si::fixed<std::int64_t, 16>>::value, "");
+        static_assert(std::is_same<std::common_type_t<short, q16>, q16>::value, "");
+        static_assert(std::is_same<std::common_type_t<q16, double>, double>::value, "");
+        static_assert(std::is_same<std::common_type_t<float, q16>, float>::value, "");
+    }
+}
+
+TEST_CASE("Units of fixed point representations", "[fixed]")
+{
+    using mm = si::length<q16, std::milli>;
+    using m = si::length<q16>;
+    using km = si::length<q16, std::kilo>;
+
+    SECTION("unit_cast scales and rounds once")
+    {
+        static_assert(si::unit_cast<m>(mm{1500}).count() == q16{1.5}, "");
+        CHECK(si::unit_cast<mm>(m{q16{1.5}}).count() == 1500);
+        CHECK(si::unit_cast<km>(m{1234}).count() == q16{1.234});
+        CHECK(si::unit_cast<si::length<q8>>(mm{q16{999.75}}).count() == q8{1});
+        CHECK(si::unit_cast<si::length<q32, std::micro>>(km{q16{0.5}}).count() == 500000000);
+
+        // one in a thousand is not a dyadic fraction, every value is still rounded right
+        check_rounding<si::rounding::toward_zero>();
+        check_rounding<si::rounding::down>();
+        check_rounding<si::rounding::nearest>();
+    }
+
+    SECTION("To and from integers and floating point")
+    {
+        CHECK(si::unit_cast<si::length<int, std::milli>>(m{q16{1.2346}}).count() == 1235);
+        CHECK(si::unit_cast<m>(si::length<int, std::kilo>{3}).count() == 3000);
+        CHECK(si::unit_cast<si::length<double, std::milli>>(m{q16{1.25}}).count() == 1250.0);
+        CHECK(si::unit_cast<m>(si::length<double, std::milli>{1250.0}).count() == q16{1.25});
+        CHECK(si::unit_cast<m>(si::length<float, std::kilo>{0.001f}).count() == 1);
+
+        // the raw value times the multiplier of the ratio is beyond 64 bits, the result is not
+        using q30 = si::fixed<std::int32_t, 30>;
+        const si::length<q30, std::ratio<999999999997, 7>> x{q30{0.01}};
+        CHECK(x.count().raw() == 10737418);
+        CHECK(si::unit_cast<si::length<int>>(x).count() == 1428571397);
+    }
+
+    SECTION("Fractions are never truncated implicitly")
+    {
+        static_assert(std::is_convertible<si::length<int>, m>::value, "");
+        static_assert(std::is_convertible<mm, si::length<q8>>::value, "");
+        static_assert(std::is_convertible<mm, si::length<double>>::value, "");
+        static_assert(!std::is_convertible<mm, si::length<int>>::value, "");
+        static_assert(!std::is_convertible<si::length<double>, mm>::value, "");
+    }
+
+    SECTION("Operators")
+    {
+        const mm a{q16{250}};
+        const m b{q16{1.5}};
+        CHECK(a + b == m{q16{1.75}});
+        CHECK(b - a == mm{1250});
+        CHECK(a < b);
+        CHECK((b * 2).count() == 3);
+
+        const auto work = si::force<q16>{q16{2.5}} * m{q16{1.5}};
+        static_assert(std::is_same<decltype(work)::base, si::energy<int>::base>::value, "");
+        CHECK(work.count() == q16{3.75});
+        const auto power = si::energy<q16>{q16{7.5}} / si::time<q16>{2};
+        static_assert(std::is_same<decltype(power)::base, si::power<int>::base>::value, "");
+        CHECK(power.count() == q16{3.75});
+    }
+}
@@ -0,0 +1,199 @@
+#include <catch.hpp>
+
+#include "si/charconv.hpp"
+#include "si/half.hpp"
+#include "si/units.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+float from_bits(std::uint32_t bits)
+{
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+template<typename _Unit>
+std::string format(const _Unit &value)
+{
+    char buffer[64];
+    const auto r = si::to_chars(buffer, buffer + sizeof(buffer), value);
+    return {buffer, r.ptr};
+}
+} // namespace
+
+TEST_CASE("bfloat16", "[half]")
+{
+    SECTION("Rounds to nearest even")
+    {
+        CHECK(si::bfloat16{1.0f}.bits() == 0x3f80);
+        CHECK(si::bfloat16{from_bits(0x3f808000)}.bits() == 0x3f80);  // tie, to even
+        CHECK(si::bfloat16{from_bits(0x3f818000)}.bits() == 0x3f82);  // tie, to even
+        CHECK(si::bfloat16{from_bits(0x3f808001)}.bits() == 0x3f81);
+        CHECK(si::bfloat16{from_bits(0x7f7fffff)}.bits() == 0x7f80);  // rounds up to infinity
+        CHECK(si::bfloat16{-2.0f}.bits() == 0xc000);
+    }
+
+    SECTION("Every bfloat16 widens to float and back exactly")
+    {
+        for (std::uint32_t bits = 0; bits <= 0xffff; ++bits) {
+            const auto b = si::bfloat16::from_bits(static_cast<std::uint16_t>(bits));
+            const float f = b;
+            if (std::isnan(f)) {
+                REQUIRE(std::isnan(static_cast<float>(si::bfloat16{f})));
+            } else {
+                REQUIRE(si::bfloat16{f}.bits() == bits);
+            }
+        }
+    }
+
+    SECTION("NaNs stay NaNs")
+    {
+        CHECK(std::isnan(static_cast<float>(si::bfloat16{from_bits(0x7f800001)})));
+        CHECK(std::isnan(static_cast<float>(si::bfloat16{from_bits(0xffffffff)})));
+        CHECK(std::isnan(static_cast<float>(std::numeric_limits<si::bfloat16>::quiet_NaN())));
+    }
+
+    SECTION("Limits")
+    {
+        using limits = std::numeric_limits<si::bfloat16>;
+        CHECK(static_cast<float>(limits::max()) == from_bits(0x7f7f0000));
+        CHECK(static_cast<float>(limits::lowest()) == -from_bits(0x7f7f0000));
+        CHECK(static_cast<float>(limits::epsilon()) == 0.0078125f);
+        CHECK(static_cast<float>(limits::min()) == std::numeric_limits<float>::min());
+        CHECK(std::isinf(static_cast<float>(limits::infinity())));
+    }
+}
+
+TEST_CASE("Units of 16 bit floating point representations", "[half]")
+{
+    using m_bf16 = si::length<si::bfloat16>;
+
+    SECTION("Common types")
+    {
+        static_assert(std::is_same<std::common_type_t<si::bfloat16, int>, si::bfloat16>::value, "");
+        static_assert(std::is_same<std::common_type_t<long, si::bfloat16>, si::bfloat16>::value, "");
+        static_assert(std::is_same<std::common_type_t<si::bfloat16, float>, float>::value, "");
+        static_assert(std::is_same<std::common_type_t<double, si::bfloat16>, double>::value, "");
+        static_assert(std::is_same<std::common_type_t<si::bfloat16, si::bfloat16>, si::bfloat16>::value, "");
+        static_assert(std::is_same<std::common_type_t<m_bf16, si::length<int, std::milli>>,
+                                   si::length<si::bfloat16, std::milli>>::value, "");
+        static_assert(std::is_same<std::common_type_t<m_bf16, si::length<double>>, si::length<double>>::value, "");
+#if SI_HAS_FLOAT16
+        static_assert(std::is_same<std::common_type_t<si::bfloat16, si::float16_t>, float>::value, "");
+        static_assert(std::is_same<std::common_type_t<si::length<si::float16_t>, m_bf16>,
+                                   si::length<float>>::value, "");
+#endif
+    }
+
+    SECTION("Conversions that could truncate stay explicit")
+    {
+        static_assert(si::treat_as_floating_point_v<si::bfloat16>, "");
+        static_assert(std::is_convertible<si::length<int>, m_bf16>::value, "");
+        static_assert(std::is_convertible<si::length<double>, m_bf16>::value, "");
+        static_assert(!std::is_convertible<m_bf16, si::length<int>>::value, "");
+        static_assert(!std::is_convertible<m_bf16, si::length<std::int64_t, std::milli>>::value, "");
+#if SI_HAS_FLOAT16
+        static_assert(si::treat_as_floating_point_v<si::float16_t>, "");
+        static_assert(std::is_convertible<si::length<int>, si::length<si::float16_t>>::value, "");
+        static_assert(std::is_convertible<m_bf16, si::length<si::float16_t>>::value, "");
+        static_assert(!std::is_convertible<si::length<si::float16_t>, si::length<int>>::value, "");
+#endif
+    }
+
+    SECTION("Arithmetic and unit_cast")
+    {
+        constexpr m_bf16 a{1.5f};
+        constexpr si::length<int, std::milli> b{500};
+        constexpr auto sum = a + b;
+        static_assert(static_cast<float>(sum.count()) == 2000.0f, "");
+
+        m_bf16 c{2.0f};
+        c += si::length<int, std::milli>{500};
+        c *= 2.0f;
+        CHECK(static_cast<float>(c.count()) == 5.0f);
+        CHECK(a < si::meter{2});
+        CHECK(a == si::length<int, std::milli>{1500});
+
+        // the ratio is applied in float, the result is only rounded once
+        const auto km = si::unit_cast<si::length<si::bfloat16, std::kilo>>(si::length<int>{1234});
+        CHECK(km.count().bits() == si::bfloat16{1.234f}.bits());
+        CHECK(si::unit_cast<si::length<int>>(km).count() == 1234);
+    }
+
+    SECTION("Saturating and checked conversions")
+    {
+        const auto big = si::unit_cast<m_bf16>(si::length<double>{1e39}, si::checked);
+        CHECK(big.overflow);
+        CHECK(big.value.count().bits() == std::numeric_limits<si::bfloat16>::max().bits());
+        CHECK_FALSE(si::unit_cast<m_bf16>(si::length<double>{1e38}, si::checked).overflow);
+        CHECK(si::unit_cast<si::length<std::int8_t>>(m_bf16{300.0f}, si::saturate).count() == 127);
+#if SI_HAS_FLOAT16
+        using m_f16 = si::length<si::float16_t>;
+        const auto f16 = si::unit_cast<m_f16>(si::length<float, std::kilo>{100}, si::checked);
+        CHECK(f16.overflow);
+        CHECK(static_cast<float>(f16.value.count()) == 65504.0f);
+        CHECK_FALSE(si::unit_cast<m_f16>(si::length<float, std::kilo>{65}, si::checked).overflow);
+#endif
+    }
+
+    SECTION("Parsing and formatting with the fewest digits")
+    {
+        m_bf16 m;
+        const char tenth[] = "0.1 m";
+        REQUIRE(si::from_chars(tenth, tenth + sizeof(tenth) - 1, m).ec == si::parse_errc::ok);
+        CHECK(m.count().bits() == si::bfloat16{0.1f}.bits());
+        CHECK(format(m) == "0.1 m");
+        CHECK(format(si::length<si::bfloat16, std::milli>{1.5f}) == "1.5 mm");
+
+        const char big[] = "1e39 m";
+        CHECK(si::from_chars(big, big + sizeof(big) - 1, m).ec == si::parse_errc::out_of_range);
+#if SI_HAS_FLOAT16
+        si::length<si::float16_t> h;
+        const char text[] = "123.4 km";
+        CHECK(si::from_chars(text, text + sizeof(text) - 1, h).ec == si::parse_errc::out_of_range);
+        const char small[] = "12.34 m";
+        REQUIRE(si::from_chars(small, small + sizeof(small) - 1, h).ec == si::parse_errc::ok);
+        CHECK(format(h) == "12.34 m");
+#endif
+    }
+}
+
+TEST_CASE("Widening and narrowing arrays", "[half]")
+{
+    for (std::size_t n : {0, 1, 15, 16, 17, 100, 1000}) {
+        std::vector<si::length<float, std::milli>> in;
+        for (std::size_t i = 0; i < n; ++i) in.emplace_back(static_cast<float>(i) * 1.37f - 50.0f);
+
+        std::vector<si::length<si::bfloat16, std::milli>> narrowed(n);
+        std::vector<si::length<float, std::milli>> widened(n);
+        CHECK(si::narrow(si::span<const si::length<float, std::milli>>{in},
+                         si::span<si::length<si::bfloat16, std::milli>>{narrowed}).size() == n);
+        CHECK(si::widen(si::span<const si::length<si::bfloat16, std::milli>>{narrowed},
+                        si::span<si::length<float, std::milli>>{widened}).size() == n);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(narrowed[i].count().bits() == si::bfloat16{in[i].count()}.bits());
+            REQUIRE(widened[i].count() == static_cast<float>(narrowed[i].count()));
+        }
+
+#if SI_HAS_FLOAT16
+        std::vector<si::length<si::float16_t, std::milli>> halves(n);
+        si::narrow(si::span<const si::length<float, std::milli>>{in},
+                   si::span<si::length<si::float16_t, std::milli>>{halves});
+        si::widen(si::span<const si::length<si::float16_t, std::milli>>{halves},
+                  si::span<si::length<float, std::milli>>{widened});
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(halves[i].count() == static_cast<si::float16_t>(in[i].count()));
+            REQUIRE(widened[i].count() == static_cast<float>(halves[i].count()));
+        }
+#endif
+    }
+}
@@ -0,0 +1,128 @@
+#include <catch.hpp>
+
+#include "si/lut.hpp"
+#include "si/units.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+using kelvin     = si::temperature<double>;
+using millivolt  = si::voltage<double, std::milli>;
+using table_type = si::lut<kelvin, millivolt, 11>;
+
+// 2 mV per K from 1 mV at 0 K
+constexpr table_type line{kelvin{0}, kelvin{10},
+                          {millivolt{1}, millivolt{3}, millivolt{5}, millivolt{7}, millivolt{9}, millivolt{11},
+                           millivolt{13}, millivolt{15}, millivolt{17}, millivolt{19}, millivolt{21}}};
+
+template<std::size_t _N>
+si::lut<kelvin, millivolt, _N> sine(double first, double last)
+{
+    std::array<millivolt, _N> values;
+    for (std::size_t i = 0; i < _N; ++i) values[i] = millivolt{std::sin(first + (last - first) * i / (_N - 1))};
+    return {kelvin{first}, kelvin{last}, values};
+}
+} // namespace
+
+TEST_CASE("Tables interpolate linearly between their entries", "[lut]")
+{
+    CHECK(line(kelvin{2.5}).count() == 6);
+    CHECK(line(kelvin{0}).count() == 1);
+    CHECK(line(kelvin{10}).count() == 21);
+    CHECK(line(kelvin{3.25}).count() == Approx(7.5));
+    CHECK(line.linear(kelvin{9.75}).count() == Approx(20.5));
+    CHECK(line.first() == kelvin{0});
+    CHECK(line.last() == kelvin{10});
+    CHECK(table_type::size() == 11);
+}
+
+TEST_CASE("Inputs outside the table are clamped to its ends", "[lut]")
+{
+    CHECK(line(kelvin{-4}).count() == 1);
+    CHECK(line(kelvin{12}).count() == 21);
+    CHECK(line.cubic(kelvin{-4}).count() == 1);
+    CHECK(line.cubic(kelvin{1e9}).count() == 21);
+}
+
+TEST_CASE("Inputs of another prefix or representation are scaled", "[lut]")
+{
+    CHECK(line(si::temperature<int, std::milli>{2500}).count() == Approx(6));
+    CHECK(line(si::temperature<float, std::kilo>{0.005f}).count() == Approx(11));
+
+    // an integral table gives integral values
+    const si::lut<si::temperature<int, std::milli>, si::voltage<int, std::micro>, 3> coarse{
+        si::temperature<int, std::milli>{0}, si::temperature<int, std::milli>{2000},
+        {si::voltage<int, std::micro>{0}, si::voltage<int, std::micro>{100}, si::voltage<int, std::micro>{300}}};
+    CHECK(coarse(kelvin{1.5}).count() == 200);
+    CHECK(coarse(kelvin{0.5}).count() == 50);
+
+    // and rounds them to the nearest rather than truncating
+    CHECK(coarse(si::temperature<int, std::milli>{1999}).count() == 300);
+    const si::lut<si::temperature<int, std::milli>, si::voltage<int, std::milli>, 3> falling{
+        si::temperature<int, std::milli>{0}, si::temperature<int, std::milli>{2000},
+        {si::voltage<int, std::milli>{0}, si::voltage<int, std::milli>{-5}, si::voltage<int, std::milli>{-10}}};
+    CHECK(falling(si::temperature<int, std::milli>{1333}).count() == -7);
+    CHECK(falling(si::temperature<int, std::milli>{1000}).count() == -5);
+}
+
+TEST_CASE("Cubic interpolation goes through the entries and follows curves", "[lut]")
+{
+    const auto table = sine<9>(0, 3);
+    for (std::size_t i = 0; i < 9; ++i) {
+        const kelvin x{3.0 * i / 8};
+        CHECK(table.cubic(x).count() == Approx(std::sin(x.count())));
+    }
+
+    double linear_error = 0, cubic_error = 0;
+    for (int i = 0; i <= 300; ++i) {
+        const kelvin x{i / 100.0};
+        linear_error = std::max(linear_error, std::abs(table.linear(x).count() - std::sin(x.count())));
+        cubic_error = std::max(cubic_error, std::abs(table.cubic(x).count() - std::sin(x.count())));
+    }
+    CHECK(cubic_error < linear_error / 4);
+
+    // a line stays a line
+    CHECK(line.cubic(kelvin{3.25}).count() == Approx(7.5));
+    CHECK(line.cubic(kelvin{0.5}).count() == Approx(2));
+}
+
+TEST_CASE("Arrays are evaluated like single inputs", "[lut]")
+{
+    const auto table = sine<64>(-1, 4);
+    std::vector<si::temperature<float, std::milli>> in;
+    for (int i = 0; i < 1001; ++i) in.emplace_back(static_cast<float>(i * 6 - 1500));
+    std::vector<millivolt> out(in.size() + 1, millivolt{-7});
+
+    auto written = table.linear(si::span<const si::temperature<float, std::milli>>{in}, si::span<millivolt>{out});
+    REQUIRE(written.size() == in.size());
+    CHECK(out.back().count() == -7);
+    for (std::size_t i = 0; i < in.size(); ++i) CHECK(out[i].count() == Approx(table.linear(in[i]).count()));
+
+    table.cubic(si::span<si::temperature<float, std::milli>>{in}, si::span<millivolt>{out});
+    for (std::size_t i = 0; i < in.size(); ++i) CHECK(out[i].count() == Approx(table.cubic(in[i]).count()));
+}
+
+#if SI_CONVERT_X86_DISPATCH
+TEST_CASE("Every kernel supported by this machine evaluates arrays alike", "[lut]")
+{
+    const auto table = sine<32>(0, 2);
+    std::vector<kelvin> in;
+    for (int i = 0; i < 123; ++i) in.emplace_back(i / 50.0 - 0.2);
+    std::vector<millivolt> expected(in.size()), out(in.size());
+    si::detail::lut_scalar<true>(table, in.data(), expected.data(), in.size());
+
+    const auto isa = si::detail::native_isa();
+    if (isa >= si::detail::isa::avx2) {
+        si::detail::lut_avx2<true>(table, in.data(), out.data(), in.size());
+        for (std::size_t i = 0; i < in.size(); ++i) CHECK(out[i].count() == Approx(expected[i].count()));
+    }
+    if (isa >= si::detail::isa::avx512dq) {
+        si::detail::lut_avx512<true>(table, in.data(), out.data(), in.size());
+        for (std::size_t i = 0; i < in.size(); ++i) CHECK(out[i].count() == Approx(expected[i].count()));
+    }
+}
+#endif
@@ -0,0 +1,135 @@
+#include <catch.hpp>
+
+#include "si/numeric.hpp"
+#include "si/unit_vector.hpp"
+#include "si/units.hpp"
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <list>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+// one large value followed by many values too small to change it on their own
+std::vector<si::energy<float>> lossy_readings(std::size_t n)
+{
+    std::vector<si::energy<float>> v{si::energy<float>{1e8f}};
+    for (std::size_t i = 0; i < n; ++i) v.emplace_back(1.0f);
+    return v;
+}
+
+template<typename _Range, typename = void>
+struct summable : std::false_type {};
+
+template<typename _Range>
+struct summable<_Range, std::void_t<decltype(si::sum(std::declval<const _Range &>()))>> : std::true_type {};
+} // namespace
+
+TEST_CASE("Sums of units", "[numeric]")
+{
+    SECTION("Result types")
+    {
+        using std::declval;
+        static_assert(std::is_same<decltype(si::sum(declval<std::vector<si::length<float>>>())), si::length<float>>::value, "");
+        static_assert(std::is_same<decltype(si::sum(declval<std::vector<si::length<int, std::milli>>>())),
+                                   si::length<std::int64_t, std::milli>>::value, "");
+        static_assert(std::is_same<decltype(si::sum(declval<std::vector<si::length<std::uint16_t>>>())),
+                                   si::length<std::uint64_t>>::value, "");
+        static_assert(std::is_same<decltype(si::mean(declval<std::vector<si::length<int>>>())), si::length<double>>::value, "");
+        static_assert(std::is_same<decltype(si::mean(declval<std::vector<si::length<float>>>())), si::length<float>>::value, "");
+#if SI_HAS_INT128
+        static_assert(std::is_same<si::sum_rep_t<std::int64_t>, si::int128_t>::value, "");
+#endif
+    }
+
+    SECTION("Floating point sums are compensated")
+    {
+        const auto readings = lossy_readings(10000);
+        CHECK(si::sum(readings).count() == 1e8f + 10000.0f);
+
+        si::energy<float> naive{0.0f};
+        for (const auto &e : readings) naive += e;
+        CHECK(naive.count() == 1e8f);
+    }
+
+    SECTION("Integral sums do not overflow")
+    {
+        const std::vector<si::length<std::int32_t>> values(1000, si::length<std::int32_t>{std::numeric_limits<std::int32_t>::max()});
+        CHECK(si::sum(values).count() == std::int64_t{1000} * std::numeric_limits<std::int32_t>::max());
+        CHECK(si::mean(values).count() == static_cast<double>(std::numeric_limits<std::int32_t>::max()));
+    }
+
+    SECTION("Any contiguous range")
+    {
+        const si::length<int> array[] = {si::length<int>{1}, si::length<int>{2}, si::length<int>{3}};
+        CHECK(si::sum(array).count() == 6);
+        CHECK(si::sum(si::span<const si::length<int>>{array}).count() == 6);
+        CHECK(si::sum(si::unit_vector<si::length<int>>{si::length<int>{4}, si::length<int>{5}}).count() == 9);
+        CHECK(si::sum(std::vector<si::length<double>>{}).count() == 0.0);
+        CHECK(si::mean(array) == si::length<int>{2});
+        CHECK(si::reduce(array, si::length<int>{10}, [](auto a, auto b) { return a + b; }) == si::length<int>{16});
+    }
+
+    SECTION("Ranges that are not one array are rejected")
+    {
+        static_assert(summable<std::vector<si::length<double>>>::value, "");
+        static_assert(summable<std::array<si::length<double>, 3>>::value, "");
+        static_assert(!summable<std::list<si::length<double>>>::value, "");
+        static_assert(!summable<std::deque<si::length<double>>>::value, "");
+    }
+
+    SECTION("Minimum and maximum")
+    {
+        std::vector<si::length<int, std::milli>> values;
+        for (int i = 0; i < 1000; ++i) values.emplace_back((i * 7919) % 2003 - 1000);
+        const auto extremes = si::min_max(values);
+        CHECK(extremes.min.count() == -1000);
+        CHECK(extremes.max.count() == 1002);
+    }
+}
+
+TEST_CASE("Dot products of units", "[numeric]")
+{
+    std::vector<si::force<double>> forces;
+    std::vector<si::length<double>> lengths;
+    for (int i = 0; i < 100; ++i) {
+        forces.emplace_back(0.5 * i);
+        lengths.emplace_back(2.0);
+    }
+
+    const auto work = si::dot(forces, lengths);
+    static_assert(std::is_same<decltype(work), const si::energy<double>>::value, "");
+    CHECK(work.count() == 4950.0);
+
+    // products of integers are computed in the wider representation
+    const std::array<si::force<std::int32_t>, 2> f{si::force<std::int32_t>{100000}, si::force<std::int32_t>{-100000}};
+    const std::array<si::length<std::int32_t>, 2> l{si::length<std::int32_t>{100000}, si::length<std::int32_t>{200000}};
+    const auto e = si::dot(f, l);
+    static_assert(std::is_same<decltype(e)::rep, std::int64_t>::value, "");
+    CHECK(e.count() == std::int64_t{-10000000000});
+}
+
+#if SI_HAS_EXECUTION
+TEST_CASE("Parallel reductions match the sequential ones", "[numeric]")
+{
+    const std::size_t n = 1000003;
+    const auto readings = lossy_readings(n);
+    CHECK(si::sum(std::execution::par, readings).count() == si::sum(readings).count());
+    CHECK(si::sum(std::execution::par_unseq, readings).count() == 1e8f + static_cast<float>(n));
+    CHECK(si::mean(std::execution::par, readings).count() == si::mean(readings).count());
+
+    std::vector<si::length<std::int16_t>> lengths;
+    for (std::size_t i = 0; i < n; ++i) lengths.emplace_back(static_cast<std::int16_t>(i * 7919 % 60001 - 30000));
+    const auto extremes = si::min_max(std::execution::par, lengths);
+    CHECK(extremes.min == si::min_max(lengths).min);
+    CHECK(extremes.max == si::min_max(lengths).max);
+    CHECK(si::sum(std::execution::par, lengths) == si::sum(lengths));
+    CHECK(si::dot(std::execution::par, lengths, lengths) == si::dot(lengths, lengths));
+    const auto widened_sum = [](auto a, auto b) { return si::length<std::int64_t>{a} + si::length<std::int64_t>{b}; };
+    CHECK(si::reduce(std::execution::par, lengths, si::length<std::int64_t>{0}, widened_sum) == si::sum(lengths));
+}
+#endif
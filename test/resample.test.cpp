@@ -0,0 +1,176 @@
+#include <catch.hpp>
+
+#include "si/resample.hpp"
+#include "si/units.hpp"
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+using timestamp = si::time<std::int64_t, std::nano>;
+
+constexpr timestamp ms(std::int64_t n) { return timestamp{n * 1000000}; }
+
+template<typename _Unit>
+struct collect
+{
+    std::vector<si::bucket<_Unit>> &buckets;
+    void operator()(const si::bucket<_Unit> &b) const { buckets.push_back(b); }
+};
+} // namespace
+
+TEST_CASE("Buckets hold the statistics of their samples", "[resample]")
+{
+    using length = si::length<double>;
+    std::vector<si::bucket<length>> out;
+    si::resampler<length> resampler{si::second{1}};
+    collect<length> sink{out};
+
+    resampler.push(ms(0), length{1}, sink);
+    resampler.push(ms(500), length{3}, sink);
+    CHECK(out.empty());
+    resampler.push(ms(1000), length{5}, sink);
+    REQUIRE(out.size() == 1);
+
+    const auto &b = out[0];
+    CHECK(b.start.count() == 0);
+    CHECK(b.count == 2);
+    CHECK(b.mean.count() == 2);
+    CHECK(b.min.count() == 1);
+    CHECK(b.max.count() == 3);
+    CHECK(b.last.count() == 3);
+    CHECK(b.integral.count() == Approx(1 * 0.5 + 3 * 0.5));
+}
+
+TEST_CASE("Gaps are emitted with the held value integrated", "[resample]")
+{
+    using length = si::length<double>;
+    std::vector<si::bucket<length>> out;
+    si::resampler<length> resampler{si::second{1}};
+    collect<length> sink{out};
+
+    resampler.push(ms(1000), length{5}, sink);
+    resampler.push(ms(3500), length{2}, sink);
+    REQUIRE(out.size() == 2);
+    CHECK(out[0].count == 1);
+    CHECK(out[0].integral.count() == Approx(5));
+    CHECK(out[1].start == ms(2000));
+    CHECK(out[1].count == 0);
+    CHECK(out[1].integral.count() == Approx(5));
+
+    resampler.flush(sink);
+    REQUIRE(out.size() == 3);
+    CHECK(out[2].start == ms(3000));
+    CHECK(out[2].count == 1);
+    CHECK(out[2].last.count() == 2);
+    CHECK(out[2].integral.count() == Approx(5 * 0.5));
+
+    // starts over after a flush
+    resampler.push(ms(10000), length{1}, sink);
+    resampler.flush(sink);
+    REQUIRE(out.size() == 4);
+    CHECK(out[3].start == ms(10000));
+    CHECK(out[3].integral.count() == 0);
+}
+
+TEST_CASE("Samples out of order are accepted up to the tolerance", "[resample]")
+{
+    using length = si::length<double>;
+    std::vector<si::bucket<length>> out;
+    si::resampler<length> resampler{si::second{1}, si::millisecond{500}};
+    collect<length> sink{out};
+
+    resampler.push(ms(200), length{1}, sink);
+    resampler.push(ms(900), length{2}, sink);
+    resampler.push(ms(600), length{10}, sink);
+    resampler.push(ms(1400), length{3}, sink);
+    CHECK(out.empty());
+    resampler.push(ms(1600), length{4}, sink);
+    REQUIRE(out.size() == 1);
+
+    CHECK(out[0].count == 3);
+    CHECK(out[0].mean.count() == Approx(13.0 / 3));
+    CHECK(out[0].min.count() == 1);
+    CHECK(out[0].max.count() == 10);
+    CHECK(out[0].last.count() == 2);
+    // the out of order sample is not in the integral
+    CHECK(out[0].integral.count() == Approx(1 * 0.7 + 2 * 0.1));
+
+    resampler.push(ms(950), length{7}, sink);
+    CHECK(resampler.dropped() == 1);
+    resampler.push(ms(1200), length{0}, sink);
+    CHECK(resampler.dropped() == 1);
+
+    resampler.flush(sink);
+    REQUIRE(out.size() == 2);
+    CHECK(out[1].count == 3);
+    CHECK(out[1].min.count() == 0);
+    CHECK(out[1].max.count() == 4);
+    CHECK(out[1].last.count() == 4);
+    CHECK(out[1].integral.count() == Approx(2 * 0.4 + 3 * 0.2));
+}
+
+TEST_CASE("Buckets are aligned on their width before the epoch too", "[resample]")
+{
+    using length = si::length<std::int32_t, std::milli>;
+    std::vector<si::bucket<length>> out;
+    si::resampler<length> resampler{si::millisecond{10}};
+    collect<length> sink{out};
+    CHECK(resampler.width() == ms(10));
+
+    resampler.push(ms(-15), length{4}, sink);
+    resampler.push(ms(-5), length{6}, sink);
+    resampler.push(ms(5), length{9}, sink);
+    resampler.flush(sink);
+
+    REQUIRE(out.size() == 3);
+    CHECK(out[0].start == ms(-20));
+    CHECK(out[1].start == ms(-10));
+    CHECK(out[2].start == ms(0));
+    CHECK(out[0].mean.count() == 4);
+    CHECK(out[1].last.count() == 6);
+    // 4 mm held for 5 ms, in mm s
+    CHECK(out[0].integral.count() == Approx(4 * 5e-3));
+}
+
+TEST_CASE("Integrals keep the prefix of the values", "[resample]")
+{
+    using power = si::power<double, std::kilo>;
+    std::vector<si::bucket<power>> out;
+    si::resampler<power> resampler{si::second{60}};
+    collect<power> sink{out};
+
+    resampler.push(ms(0), power{2}, sink);
+    resampler.push(ms(60000), power{0}, sink);
+    REQUIRE(out.size() == 1);
+    // 2 kW for a minute, in kJ
+    static_assert(std::is_same<si::bucket<power>::integral_type, si::energy<double, std::kilo>>::value, "");
+    CHECK(out[0].integral.count() == Approx(120));
+}
+
+TEST_CASE("Every sample within the tolerance lands in its bucket", "[resample]")
+{
+    using length = si::length<double>;
+    std::vector<si::bucket<length>> out;
+    si::resampler<length> resampler{si::millisecond{7}, si::millisecond{20}};
+    collect<length> sink{out};
+
+    std::size_t pushed = 0;
+    for (std::int64_t i = 0; i < 1000; ++i) {
+        // every block of four arrives backwards
+        const auto t = (i - i % 4) + 3 - i % 4;
+        resampler.push(ms(t * 3), length{static_cast<double>(t)}, sink);
+        ++pushed;
+    }
+    resampler.flush(sink);
+    CHECK(resampler.dropped() == 0);
+
+    std::size_t counted = 0;
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        counted += out[i].count;
+        CHECK(out[i].start == ms(7 * static_cast<std::int64_t>(i)));
+    }
+    CHECK(counted == pushed);
+}
@@ -1,13 +1,30 @@
 #include <catch.hpp>
 
+#include "si/io.hpp"
 #include "si/si.hpp"
 
+#include <array>
+#include <sstream>
 #include <type_traits>
+#include <vector>
 
 // for testing purposes we declare a convenience type with some sane defaults
 template<typename _Rep = int, typename _Ratio = std::ratio<1>, typename _Base = si::detail::base<>>
 using test_unit = si::unit<_Rep, _Ratio, _Base>;
 
+template<typename T, typename U, typename = void>
+struct has_plus_assign : std::false_type {};
+
+template<typename T, typename U>
+struct has_plus_assign<T, U, std::void_t<decltype(std::declval<T &>() += std::declval<U>())>>
+    : std::true_type {};
+
+template<typename T, typename = void>
+struct has_as_units : std::false_type {};
+
+template<typename T>
+struct has_as_units<T, std::void_t<decltype(si::as_units(std::declval<T>()))>> : std::true_type {};
+
 TEST_CASE("Common Type", "[common_type]")
 {
     using t1 = std::common_type_t<std::ratio<1, 5>, std::ratio<1, 10>>;
@@ -15,7 +32,9 @@ TEST_CASE("Common Type", "[common_type]")
     using t2 = std::common_type_t<std::ratio<10, 3>, std::ratio<1, 10>>;
     CHECK(std::is_same<t2, std::ratio<1, 30>>::value);
     using t3 = std::common_type_t<std::ratio<2, 42>, std::ratio<42, 10>>;
-    CHECK(std::is_same<t3, std::ratio<2, 210>>::value);
+    CHECK(std::is_same<t3, std::ratio<1, 105>>::value);
+    using t4 = std::common_type_t<std::ratio<2, 4>, std::ratio<3, 6>>;
+    CHECK(std::is_same<t4, std::ratio<1, 2>>::value);
 }
 
 TEST_CASE("Base instantiations", "[detail]")
@@ -277,6 +296,82 @@ TEST_CASE("Unit operations", "[unit][operators]")
     }
 }
 
+TEST_CASE("Unit compound assignment", "[unit][operators]")
+{
+    SECTION("+= and -= on the same ratio")
+    {
+        test_unit<> u{1};
+        u += test_unit<>{2};
+        CHECK(u.count() == 3);
+        u -= test_unit<>{5};
+        CHECK(u.count() == -2);
+    }
+    SECTION("+= and -= convert the right hand side to the left hand side")
+    {
+        test_unit<int, std::milli> u{1};
+        u += test_unit<int>{1};
+        CHECK(u.count() == 1001);
+        u -= test_unit<int, std::centi>{1};
+        CHECK(u.count() == 991);
+
+        test_unit<double> d{1};
+        d += test_unit<int, std::milli>{500};
+        CHECK(d.count() == Approx(1.5));
+    }
+    SECTION("+= and -= are not allowed to truncate floating types into integral ones")
+    {
+        CHECK(has_plus_assign<test_unit<double>, test_unit<int>>::value);
+        CHECK(has_plus_assign<test_unit<double>, test_unit<double, std::kilo>>::value);
+        CHECK_FALSE(has_plus_assign<test_unit<int>, test_unit<double>>::value);
+        CHECK_FALSE(has_plus_assign<test_unit<int>, test_unit<int, std::ratio<1>, si::detail::_m<>>>::value);
+        CHECK(has_plus_assign<si::time<double>, si::time<int>>::value);
+        CHECK_FALSE(has_plus_assign<si::time<int>, si::time<double>>::value);
+    }
+    SECTION("*= and /= scale the count")
+    {
+        test_unit<> u{6};
+        u *= 7;
+        CHECK(u.count() == 42);
+        u /= 4;
+        CHECK(u.count() == 10);
+    }
+    SECTION("Increment and decrement")
+    {
+        test_unit<> u{1};
+        CHECK((++u).count() == 2);
+        CHECK((u++).count() == 2);
+        CHECK(u.count() == 3);
+        CHECK((--u).count() == 2);
+        CHECK((u--).count() == 2);
+        CHECK(u.count() == 1);
+    }
+    SECTION("Time units support the same operations")
+    {
+        si::millisecond ms{250};
+        ms += si::second{1};
+        CHECK(ms.count() == 1250);
+        ms -= si::millisecond{50};
+        CHECK(ms.count() == 1200);
+        ms *= 2;
+        ms /= 3;
+        CHECK(ms.count() == 800);
+        ++ms;
+        ms--;
+        CHECK(ms.count() == 800);
+    }
+    SECTION("Compound assignment is usable in constant expressions")
+    {
+        constexpr auto u = [] {
+            test_unit<int, std::milli> v{1};
+            v += test_unit<int>{2};
+            v *= 2;
+            return v;
+        }();
+        static_assert(u.count() == 4002, "");
+        CHECK(u.count() == 4002);
+    }
+}
+
 TEST_CASE("Unit multiplication", "[unit][operators]")
 {
     using test_unit1 = si::unit<int, std::ratio<1>, si::detail::base<1>>;
@@ -313,6 +408,20 @@ TEST_CASE("Unit multiplication with different ratios", "[unit][operators]")
     CHECK(std::is_same<decltype(result2), test_unit12>::value);
 }
 
+TEST_CASE("Equal ratios give a single unit type", "[unit][operators]")
+{
+    using half = si::unit<int, std::ratio<1, 2>, si::detail::base<1>>;
+    using also_half = si::unit<int, std::ratio<3, 6>, si::detail::base<1>>;
+    using half_squared = si::unit<int, std::ratio<1, 2>, si::detail::base<2>>;
+
+    CHECK(std::is_same<decltype(also_half{1} + also_half{1}), half>::value);
+    CHECK(std::is_same<decltype(half{1} - also_half{1}), half>::value);
+    CHECK(std::is_same<decltype(also_half{2} * half{3}), half_squared>::value);
+    CHECK(std::is_same<decltype(half_squared{4} / also_half{2}), half>::value);
+    CHECK(std::is_same<si::velocity<int, std::ratio<3, 6>>, si::velocity<int, std::ratio<1, 2>>>::value);
+    CHECK(also_half{2} * half{3} == half_squared{6});
+}
+
 TEST_CASE("Unit division", "[unit][operators]")
 {
     using test_unit1 = si::unit<double, std::ratio<1>, si::detail::base<1>>;
@@ -366,6 +475,165 @@ TEST_CASE("Unit conversions", "[unit][unit_cast]")
     }
 }
 
+TEST_CASE("Unit conversion paths", "[unit][unit_cast]")
+{
+    SECTION("Identity ratio only converts the representation")
+    {
+        CHECK(si::unit_cast<test_unit<long>>(test_unit<int>{42}).count() == 42);
+        CHECK(si::unit_cast<test_unit<int>>(test_unit<double>{2.5}).count() == 2);
+        CHECK(si::unit_cast<test_unit<int, std::milli>>(test_unit<int, std::milli>{-7}).count() == -7);
+    }
+
+    SECTION("Multiply only")
+    {
+        CHECK(si::unit_cast<test_unit<int, std::milli>>(test_unit<int>{3}).count() == 3000);
+        CHECK(si::unit_cast<test_unit<int, std::milli>>(test_unit<int, std::kilo>{-2}).count() == -2000000);
+    }
+
+    SECTION("Divide only")
+    {
+        CHECK(si::unit_cast<test_unit<int>>(test_unit<int, std::milli>{2999}).count() == 2);
+        CHECK(si::unit_cast<test_unit<int>>(test_unit<int, std::milli>{-2999}).count() == -2);
+        CHECK(si::unit_cast<test_unit<int, std::kilo>>(test_unit<int, std::milli>{5000000}).count() == 5);
+    }
+
+    SECTION("Floating point uses a single folded factor")
+    {
+        CHECK(si::unit_cast<test_unit<double>>(test_unit<double, std::milli>{1500}).count() == Approx(1.5));
+        CHECK(si::unit_cast<test_unit<double, std::milli>>(test_unit<int>{2}).count() == Approx(2000));
+        CHECK(si::unit_cast<test_unit<float, std::ratio<3, 7>>>(test_unit<float>{3}).count() == Approx(7));
+    }
+
+    SECTION("Integral ratios with both num and den do not overflow in the intermediate")
+    {
+        using from = test_unit<int64_t, std::ratio<3>>;
+        using to   = test_unit<int64_t, std::ratio<7>>;
+        constexpr auto big = std::numeric_limits<int64_t>::max() / 2;
+
+        CHECK(si::unit_cast<to>(from{7}).count() == 3);
+        CHECK(si::unit_cast<to>(from{10}).count() == 4);
+        CHECK(si::unit_cast<to>(from{-10}).count() == -4);
+        CHECK(si::unit_cast<to>(from{big}).count() == big / 7 * 3 + big % 7 * 3 / 7);
+    }
+
+    SECTION("unit_cast is usable in constant expressions")
+    {
+        constexpr auto mm = si::unit_cast<test_unit<int, std::milli>>(test_unit<int>{4});
+        static_assert(mm.count() == 4000, "");
+        CHECK(mm.count() == 4000);
+    }
+
+    SECTION("Factors that do not fit in the representation are widened")
+    {
+        CHECK(si::unit_cast<si::second>(si::exasecond{0}).count() == 0);
+        CHECK(si::unit_cast<si::time<int64_t>>(si::exasecond{9}).count() == 9000000000000000000);
+        CHECK(si::unit_cast<si::exasecond>(si::time<int64_t>{-9000000000000000000}).count() == -9);
+
+        // the remainder times num is above 2^63, the result is not
+        using from = test_unit<int64_t, std::ratio<1, 10000000000>>;
+        using to   = test_unit<int64_t, std::ratio<1, 9999999999>>;
+        CHECK(si::unit_cast<to>(from{9999999999}).count() == 9999999998);
+        CHECK(si::unit_cast<to>(from{-9999999999}).count() == -9999999998);
+    }
+}
+
+TEST_CASE("Saturating and checked conversions", "[unit][unit_cast]")
+{
+    SECTION("Values in range are converted exactly")
+    {
+        CHECK(si::unit_cast<si::millisecond>(si::second{-42}, si::saturate).count() == -42000);
+
+        auto r = si::unit_cast<si::time<int64_t, std::nano>>(si::time<int64_t>{9000000000}, si::checked);
+        CHECK_FALSE(r.overflow);
+        CHECK(r.value.count() == 9000000000000000000);
+    }
+
+    SECTION("Integral overflows are clamped")
+    {
+        constexpr auto max = std::numeric_limits<int>::max();
+        CHECK(si::unit_cast<si::second>(si::exasecond{1}, si::saturate).count() == max);
+        CHECK(si::unit_cast<si::second>(si::exasecond{-1}, si::saturate).count() == std::numeric_limits<int>::min());
+        CHECK(si::unit_cast<si::millisecond>(si::second{max}, si::saturate).count() == max);
+
+        auto r = si::unit_cast<si::time<int64_t, std::nano>>(si::time<int64_t>{10000000000}, si::checked);
+        CHECK(r.overflow);
+        CHECK(r.value.count() == std::numeric_limits<int64_t>::max());
+
+        CHECK(si::unit_cast<si::time<uint32_t>>(si::second{-1}, si::checked).overflow);
+        CHECK(si::unit_cast<si::time<uint32_t>>(si::second{-1}, si::saturate).count() == 0);
+        CHECK(si::unit_cast<si::time<int8_t>>(si::time<uint64_t>{~0ull}, si::saturate).count() == 127);
+    }
+
+    SECTION("Floating point overflows are clamped")
+    {
+        auto r = si::unit_cast<si::time<int, std::milli>>(si::time<double>{1e10}, si::checked);
+        CHECK(r.overflow);
+        CHECK(r.value.count() == std::numeric_limits<int>::max());
+
+        r = si::unit_cast<si::time<int, std::milli>>(si::time<double>{-2147483.6484}, si::checked);
+        CHECK_FALSE(r.overflow);
+        CHECK(r.value.count() == -2147483648);
+
+        const auto l = si::unit_cast<si::time<int64_t>>(si::time<double>{-9223372036854775808.0}, si::checked);
+        CHECK_FALSE(l.overflow);
+        CHECK(l.value.count() == std::numeric_limits<int64_t>::min());
+        CHECK(si::unit_cast<si::time<int64_t>>(si::time<double>{-9223372036854777856.0}, si::checked).overflow);
+
+        r = si::unit_cast<si::time<int, std::milli>>(si::time<double>{std::numeric_limits<double>::quiet_NaN()}, si::checked);
+        CHECK(r.overflow);
+        CHECK(r.value.count() == 0);
+
+        auto f = si::unit_cast<si::time<float, std::pico>>(si::time<double>{1e30}, si::checked);
+        CHECK(f.overflow);
+        CHECK(f.value.count() == std::numeric_limits<float>::max());
+
+        constexpr auto inf = std::numeric_limits<double>::infinity();
+        CHECK_FALSE(si::unit_cast<si::time<float, std::pico>>(si::time<double>{inf}, si::checked).overflow);
+    }
+
+    SECTION("Checked conversions are usable in constant expressions")
+    {
+        constexpr auto r = si::unit_cast<si::second>(si::exasecond{1}, si::checked);
+        static_assert(r.overflow, "");
+        CHECK(r.overflow);
+    }
+}
+
+#if SI_HAS_INT128
+TEST_CASE("128 bit representations", "[unit][unit_cast]")
+{
+    using ns = si::time<si::int128_t, std::nano>;
+    constexpr auto max = std::numeric_limits<int64_t>::max();
+
+    const ns t = si::time<int64_t>{max};
+    CHECK(t.count() == si::int128_t{max} * 1000000000);
+    CHECK(si::unit_cast<si::time<int64_t>>(t).count() == max);
+    CHECK(si::unit_cast<si::time<int64_t, std::nano>>(t, si::saturate).count() == max);
+    CHECK((t + si::time<int64_t>{1}).count() == (si::int128_t{max} + 1) * 1000000000);
+    CHECK(t > si::time<int64_t>{max - 1});
+
+    using kg = si::mass<si::uint128_t>;
+    CHECK(si::unit_cast<si::mass<uint64_t, std::micro>>(kg{1}).count() == 1000000000);
+    CHECK(si::unit_cast<si::mass<int64_t>>(kg{~si::uint128_t{0}}, si::checked).overflow);
+
+    SECTION("Saturating and checked conversions keep all 128 bits")
+    {
+        using length = si::length<si::int128_t>;
+        const length big{si::int128_t{1} << 80};
+        auto r = si::unit_cast<length>(big, si::checked);
+        CHECK_FALSE(r.overflow);
+        CHECK(r.value.count() == big.count());
+        CHECK(si::unit_cast<length>(length{-big.count()}, si::saturate).count() == -big.count());
+
+        const si::length<si::int128_t, std::kilo> km{si::int128_t{1} << 70};
+        CHECK(si::unit_cast<length>(km, si::saturate).count() == si::unit_cast<length>(km).count());
+        CHECK(si::unit_cast<si::length<si::uint128_t>>(km, si::saturate).count() == si::uint128_t{1000} << 70);
+        CHECK(si::unit_cast<si::length<int64_t, std::kilo>>(km, si::checked).overflow);
+        CHECK(si::unit_cast<length>(si::length<int64_t, std::kilo>{-1}, si::saturate).count() == -1000);
+    }
+}
+#endif
+
 TEST_CASE("Time types can be converted to chrono::duration", "[unit][conversion]")
 {
     namespace chrono = std::chrono;
@@ -379,6 +647,94 @@ TEST_CASE("Time types can be converted to chrono::duration", "[unit][conversion]
     CHECK(us == chrono::duration<long, std::milli>{42000000});
 }
 
+TEST_CASE("Time types can be converted explicitly to and from chrono::duration", "[unit][conversion]")
+{
+    namespace chrono = std::chrono;
+
+    auto d = si::to_duration(si::millisecond{42});
+    static_assert(std::is_same<decltype(d), chrono::duration<int, std::milli>>::value);
+    CHECK(d.count() == 42);
+
+    auto t = si::from_duration(chrono::microseconds{7});
+    static_assert(std::is_same<decltype(t), si::time<chrono::microseconds::rep, std::micro>>::value);
+    CHECK(t.count() == 7);
+}
+
+TEST_CASE("Time types convert to and from chrono::duration in constant expressions", "[unit][conversion]")
+{
+    namespace chrono = std::chrono;
+
+    constexpr si::time<int, std::milli> ms{1500};
+    constexpr chrono::duration<double> d = ms;
+    static_assert(d.count() == 1.5);
+
+    constexpr si::time<long long, std::micro> us = chrono::milliseconds{3};
+    static_assert(us.count() == 3000);
+
+    si::time<double> elapsed = chrono::nanoseconds{250};
+    CHECK(elapsed.count() == Approx(250e-9));
+}
+
+TEST_CASE("Lossy durations need an explicit unit_cast", "[unit][conversion]")
+{
+    namespace chrono = std::chrono;
+
+    static_assert(std::is_convertible<chrono::seconds, si::time<int, std::milli>>::value);
+    static_assert(std::is_convertible<chrono::milliseconds, si::time<double>>::value);
+    static_assert(!std::is_convertible<chrono::duration<double>, si::time<int>>::value);
+    static_assert(!std::is_convertible<chrono::milliseconds, si::time<int>>::value);
+
+    const auto t = si::unit_cast<si::time<int>>(si::from_duration(chrono::milliseconds{1999}));
+    CHECK(t.count() == 1);
+    CHECK(si::unit_cast<si::time<int>>(si::from_duration(chrono::duration<double>{1.7})).count() == 1);
+}
+
+TEST_CASE("Arrays of durations are viewed as arrays of time units", "[unit][conversion]")
+{
+    namespace chrono = std::chrono;
+
+    std::vector<chrono::nanoseconds> deadlines{chrono::nanoseconds{5}, chrono::nanoseconds{7}};
+    auto times = si::as_units(deadlines);
+    static_assert(std::is_same<decltype(times), si::span<si::time<chrono::nanoseconds::rep, std::nano>>>::value);
+    REQUIRE(times.size() == 2);
+    CHECK(static_cast<const void *>(times.data()) == static_cast<const void *>(deadlines.data()));
+    times[1] += si::time<int, std::micro>{1};
+    CHECK(deadlines[1].count() == 1007);
+
+    const auto &fixed = deadlines;
+    auto read_only = si::as_units(fixed);
+    static_assert(std::is_same<decltype(read_only),
+                               si::span<const si::time<chrono::nanoseconds::rep, std::nano>>>::value);
+
+    auto back = si::as_durations(times);
+    static_assert(std::is_same<decltype(back), si::span<chrono::nanoseconds>>::value);
+    CHECK(back.data() == deadlines.data());
+
+    std::array<si::millisecond, 1> units{si::millisecond{4}};
+    CHECK(si::as_durations(units)[0] == chrono::duration<int, std::milli>{4});
+
+    // spans are views and are taken by value, containers only by lvalue reference
+    CHECK(si::as_units(si::span<chrono::nanoseconds>{deadlines}).data() == times.data());
+    CHECK(si::as_durations(si::span<const si::millisecond>{units})[0].count() == 4);
+    static_assert(has_as_units<std::vector<chrono::nanoseconds> &>::value);
+    static_assert(!has_as_units<std::vector<chrono::nanoseconds>>::value);
+}
+
+TEST_CASE("Units can be written to streams", "[unit][io]")
+{
+    auto str = [](const auto &u) {
+        std::ostringstream os;
+        os << u;
+        return os.str();
+    };
+
+    CHECK(str(si::meter{3}) == "3 m");
+    CHECK(str(si::millisecond{-2}) == "-2 ms");
+    CHECK(str(si::kilogram{1}) == "1 kg");
+    CHECK(str(si::velocity<int>{5}) == "5 m·s⁻¹");
+    CHECK(str(si::angle<int>{1}) == "1");
+}
+
 TEST_CASE("Convenience types for base SI units", "[unit][detail][constructors]")
 {
     SECTION("Default ratios")
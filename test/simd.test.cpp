@@ -0,0 +1,97 @@
+#include <catch.hpp>
+
+#include "si/simd.hpp"
+#include "si/units.hpp"
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#if SI_HAS_SIMD
+namespace stdx = std::experimental;
+
+namespace
+{
+using pack   = stdx::fixed_size_simd<double, 4>;
+using ipack  = stdx::fixed_size_simd<std::int64_t, 4>;
+
+template<typename _Pack>
+_Pack iota(typename _Pack::value_type start)
+{
+    return _Pack([start](auto i) { return static_cast<typename _Pack::value_type>(start + i); });
+}
+
+template<typename _T, typename _U, typename = void>
+struct can_add : std::false_type {};
+
+template<typename _T, typename _U>
+struct can_add<_T, _U, std::void_t<decltype(std::declval<_T>() + std::declval<_U>())>> : std::true_type {};
+} // namespace
+
+TEST_CASE("Units of packs multiply and divide every lane", "[simd]")
+{
+    const si::length<pack> d{iota<pack>(1)};
+    const si::time<pack> t{pack(2.0)};
+
+    const auto v = d / t;
+    static_assert(std::is_same<decltype(v), const si::velocity<pack>>::value, "");
+    const auto a = v / t;
+    static_assert(std::is_same<decltype(a), const si::acceleration<pack>>::value, "");
+    for (std::size_t i = 0; i < pack::size(); ++i) CHECK(a.count()[i] == (i + 1) / 4.0);
+
+    const auto f = si::mass<pack>{pack(3.0)} * a;
+    static_assert(std::is_same<decltype(f), const si::force<pack>>::value, "");
+    CHECK(f.count()[3] == 3.0);
+
+    const auto doubled = 2.0 * d;
+    CHECK(doubled.count()[1] == 4.0);
+    static_assert(!can_add<si::length<pack>, si::time<pack>>::value, "");
+}
+
+TEST_CASE("Comparisons of units of packs give a mask", "[simd]")
+{
+    const si::length<pack> d{iota<pack>(1)};
+    const si::length<pack, std::milli> limit{pack(2500.0)};
+
+    const auto over = d > limit;
+    static_assert(std::is_same<std::decay_t<decltype(over)>, pack::mask_type>::value, "");
+    CHECK(stdx::popcount(over) == 2);
+    CHECK(stdx::all_of(d == d));
+    CHECK(stdx::none_of(d != d));
+    CHECK(stdx::popcount(d <= si::length<pack>{pack(2.0)}) == 2);
+}
+
+TEST_CASE("Units of packs convert lane by lane", "[simd]")
+{
+    const si::length<pack> m{iota<pack>(1)};
+    const auto mm = si::unit_cast<si::length<pack, std::milli>>(m);
+    for (std::size_t i = 0; i < pack::size(); ++i) CHECK(mm.count()[i] == 1000.0 * (i + 1));
+
+    const si::length<pack, std::kilo> km = m;
+    CHECK(km.count()[0] == Approx(0.001));
+
+    const si::length<ipack, std::milli> imm{iota<ipack>(1500)};
+    CHECK(si::unit_cast<si::length<ipack>>(imm).count()[1] == 1);
+    CHECK(si::unit_cast<si::length<ipack, std::micro>>(imm).count()[2] == 1502000);
+    const auto thirds = si::unit_cast<si::length<ipack, std::ratio<1, 3>>>(si::length<ipack, std::ratio<1, 2>>{iota<ipack>(1)});
+    CHECK(thirds.count()[1] == 3);
+
+    // a single unit is broadcast
+    const si::length<pack, std::milli> broadcast = si::length<double>{2.5};
+    CHECK(stdx::all_of(broadcast.count() == 2500.0));
+}
+
+TEST_CASE("Arrays of units are loaded into and stored from packs", "[simd]")
+{
+    std::array<si::length<double>, 4> lengths{si::length<double>{1}, si::length<double>{2}, si::length<double>{3},
+                                              si::length<double>{4}};
+    auto p = si::load_pack<pack>(lengths.data());
+    static_assert(std::is_same<decltype(p), si::length<pack>>::value, "");
+    p += si::length<pack, std::milli>{pack(500.0)};
+
+    std::array<si::length<double>, 4> out{};
+    si::store_pack(p, out.data());
+    CHECK(out[0].count() == 1.5);
+    CHECK(out[3].count() == 4.5);
+}
+#endif
@@ -0,0 +1,149 @@
+#include <catch.hpp>
+
+#include "si/unit_vector.hpp"
+#include "si/units.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+TEST_CASE("unit_vector layout", "[unit_vector]")
+{
+    CHECK(sizeof(si::length<double>) == sizeof(double));
+    CHECK(sizeof(si::millisecond) == sizeof(int));
+    CHECK(std::is_trivially_copyable<si::length<double>>::value);
+    CHECK(std::is_trivially_copyable<si::time<int64_t, std::nano>>::value);
+
+    CHECK_FALSE(std::is_copy_constructible<si::unit_vector<si::meter>>::value);
+    CHECK_FALSE(std::is_copy_assignable<si::unit_vector<si::meter>>::value);
+    CHECK(std::is_nothrow_move_constructible<si::unit_vector<si::meter>>::value);
+    CHECK(std::is_nothrow_move_assignable<si::unit_vector<si::meter>>::value);
+}
+
+TEST_CASE("unit_vector construction", "[unit_vector]")
+{
+    SECTION("Default constructed vectors do not allocate")
+    {
+        si::unit_vector<si::meter> v;
+        CHECK(v.empty());
+        CHECK(v.capacity() == 0);
+        CHECK(v.data() == nullptr);
+    }
+    SECTION("Sized vectors are zero initialized")
+    {
+        si::unit_vector<si::length<double>> v(5);
+        REQUIRE(v.size() == 5);
+        for (auto u : v) CHECK(u.count() == 0);
+    }
+    SECTION("Filled and listed vectors")
+    {
+        si::unit_vector<si::meter> a(3, si::meter{7});
+        CHECK(a.size() == 3);
+        CHECK(a[2] == si::meter{7});
+
+        si::unit_vector<si::meter> b{si::meter{1}, si::meter{2}, si::meter{3}};
+        CHECK(b.size() == 3);
+        CHECK(b.front() == si::meter{1});
+        CHECK(b.back() == si::meter{3});
+    }
+    SECTION("Moving transfers the buffer")
+    {
+        si::unit_vector<si::meter> a{si::meter{1}, si::meter{2}};
+        const auto *buffer = a.data();
+        si::unit_vector<si::meter> b{std::move(a)};
+        CHECK(b.data() == buffer);
+        CHECK(b.size() == 2);
+        CHECK(a.empty());
+
+        a = std::move(b);
+        CHECK(a.data() == buffer);
+        CHECK(b.data() == nullptr);
+    }
+    SECTION("clone makes an independent copy")
+    {
+        si::unit_vector<si::meter> a{si::meter{1}, si::meter{2}};
+        auto b = a.clone();
+        b[0] = si::meter{5};
+        CHECK(a[0] == si::meter{1});
+        CHECK(b[0] == si::meter{5});
+        CHECK(b.capacity() == 2);
+    }
+}
+
+TEST_CASE("unit_vector raw access", "[unit_vector]")
+{
+    si::unit_vector<si::length<double>> v{si::length<double>{1.5}, si::length<double>{2.5}};
+    double *raw = v.data();
+    CHECK(raw[0] == 1.5);
+    CHECK(raw[1] == 2.5);
+
+    raw[1] = 4;
+    CHECK(v[1].count() == 4);
+
+    si::span<const si::length<double>> view = v;
+    CHECK(view.size() == 2);
+    CHECK(view[1].count() == 4);
+}
+
+TEST_CASE("unit_vector growth", "[unit_vector]")
+{
+    si::unit_vector<si::millisecond> v;
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(si::millisecond{i});
+    }
+    REQUIRE(v.size() == 100);
+    CHECK(v.capacity() >= 100);
+    for (int i = 0; i < 100; ++i) CHECK(v[i].count() == i);
+
+    SECTION("reserve does not change the contents")
+    {
+        v.reserve(1000);
+        CHECK(v.capacity() == 1000);
+        CHECK(v[99].count() == 99);
+    }
+    SECTION("shrink_to_fit releases the spare capacity")
+    {
+        v.shrink_to_fit();
+        CHECK(v.capacity() == 100);
+        v.clear();
+        v.shrink_to_fit();
+        CHECK(v.capacity() == 0);
+    }
+    SECTION("append grows at most once")
+    {
+        si::unit_vector<si::millisecond> w(400, si::millisecond{1});
+        v.shrink_to_fit();
+        v.append(w);
+        CHECK(v.size() == 500);
+        CHECK(v.capacity() == 500);
+        CHECK(v[499].count() == 1);
+    }
+    SECTION("resize zero fills and truncates")
+    {
+        v.resize(120);
+        CHECK(v[110].count() == 0);
+        v.resize(10);
+        CHECK(v.size() == 10);
+        v.pop_back();
+        v.emplace_back(42);
+        CHECK(v.back().count() == 42);
+    }
+    SECTION("Growing past max_size throws like std::vector")
+    {
+        CHECK_THROWS_AS(v.reserve(v.max_size() + 1), std::length_error);
+        CHECK_THROWS_AS(v.resize(static_cast<std::size_t>(-1)), std::length_error);
+        CHECK(v.size() == 100);
+        CHECK(v[99].count() == 99);
+    }
+}
+
+TEST_CASE("unit_vector bulk conversion", "[unit_vector][unit_cast]")
+{
+    si::unit_vector<si::time<int64_t, std::nano>> ns;
+    for (int64_t i = 0; i < 50; ++i) ns.emplace_back(i * 1000000);
+
+    auto ms = si::unit_cast<si::time<int64_t, std::milli>>(ns);
+    CHECK(std::is_same<decltype(ms), si::unit_vector<si::time<int64_t, std::milli>>>::value);
+    REQUIRE(ms.size() == 50);
+    for (int64_t i = 0; i < 50; ++i) CHECK(ms[i].count() == i);
+}